@@ -0,0 +1,124 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Compile time and code size benchmark of the control maps. Instantiates
+// dijkstra_object for every single control point and for some combined
+// control maps. With BLINK_MPL_CONTROL_MAPS defined the same control maps
+// are given as boost::mpl vectors instead of control_point_sets.
+//
+// Compare the build times and sizes of the control_map_instantiations and
+// control_map_instantiations_mpl targets, e.g.:
+//   time make control_map_instantiations
+//   time make control_map_instantiations_mpl
+//   size control_map_instantiations control_map_instantiations_mpl
+//
+//=======================================================================
+//
+#include <blink/graph/dijkstra_control.hpp>
+#include <blink/graph/dijkstra_object.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+typedef boost::property<boost::edge_weight_t, double> edge_prop;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+  boost::no_property, edge_prop> graph_type;
+typedef boost::graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+typedef std::vector<vertex_descriptor> source_range_type;
+
+#ifdef BLINK_MPL_CONTROL_MAPS
+template<typename Set>
+struct control_map
+{
+  template<blink::control_point CP>
+  struct at : boost::integral_constant<bool, Set::contains(CP)>::type
+  {};
+
+  typedef typename boost::mpl::vector
+    < typename at<blink::cp_initialize_vertex>::type
+    , typename at<blink::cp_examine_vertex>::type
+    , typename at<blink::cp_examine_edge>::type
+    , typename at<blink::cp_tree_edge>::type
+    , typename at<blink::cp_discover_vertex>::type
+    , typename at<blink::cp_non_tree_edge>::type
+    , typename at<blink::cp_gray_target>::type
+    , typename at<blink::cp_black_target>::type
+    , typename at<blink::cp_finish_vertex>::type
+    , typename at<blink::cp_edge_relaxed>::type
+    , typename at<blink::cp_edge_not_relaxed>::type
+    >::type type;
+};
+#else
+template<typename Set>
+struct control_map
+{
+  typedef Set type;
+};
+#endif
+
+template<typename Set>
+std::size_t count_halts(const graph_type& g, const source_range_type& sources)
+{
+  typedef typename control_map<Set>::type control_map_type;
+  typename blink::dijkstra_object_helper<graph_type, const source_range_type,
+    control_map_type, boost::no_named_parameters>::type dijkstra
+    = blink::make_dijkstra_object(g, sources, control_map_type());
+
+  std::size_t halts = 0;
+  while (dijkstra()) {
+    ++halts;
+  }
+  return halts;
+}
+
+template<blink::control_point CP>
+std::size_t count_halts(const graph_type& g, const source_range_type& sources)
+{
+  return count_halts<typename blink::make_control_point_set<CP>::type>(g,
+    sources);
+}
+
+int main()
+{
+  graph_type g(4);
+  boost::add_edge(0, 1, 1.0, g);
+  boost::add_edge(0, 2, 4.0, g);
+  boost::add_edge(1, 2, 2.0, g);
+  boost::add_edge(2, 3, 1.0, g);
+  boost::add_edge(3, 1, 1.0, g);
+  const source_range_type sources(1, 0);
+  typedef decltype(~blink::dijkstra_visitor_control_point_vector())
+    non_visitor_type;
+
+  std::size_t halts = 0;
+  halts += count_halts<blink::cp_initialize_vertex>(g, sources);
+  halts += count_halts<blink::cp_examine_vertex>(g, sources);
+  halts += count_halts<blink::cp_examine_edge>(g, sources);
+  halts += count_halts<blink::cp_tree_edge>(g, sources);
+  halts += count_halts<blink::cp_discover_vertex>(g, sources);
+  halts += count_halts<blink::cp_non_tree_edge>(g, sources);
+  halts += count_halts<blink::cp_gray_target>(g, sources);
+  halts += count_halts<blink::cp_black_target>(g, sources);
+  halts += count_halts<blink::cp_finish_vertex>(g, sources);
+  halts += count_halts<blink::cp_edge_relaxed>(g, sources);
+  halts += count_halts<blink::cp_edge_not_relaxed>(g, sources);
+  halts += count_halts<blink::no_control_point_vector>(g, sources);
+  halts += count_halts<blink::dijkstra_visitor_control_point_vector>(g,
+    sources);
+  halts += count_halts<blink::all_control_points_type>(g, sources);
+  halts += count_halts<non_visitor_type>(g, sources);
+  std::cout << "halts: " << halts << std::endl;
+  return 0;
+}
@@ -0,0 +1,158 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Compares the time per event of dijkstra_generator with that of
+// dijkstra_object::operator() and dijkstra_object::fill with a buffer of
+// 256 events, on a random graph, yielding at
+// finish_vertex (once per vertex) and at examine_edge (once per edge).
+//
+// usage: dijkstra_generator_benchmark [num_vertices] [out_degree]
+//
+//=======================================================================
+//
+#include <blink/graph/dijkstra_control.hpp>
+#include <blink/graph/dijkstra_generator.hpp>
+#include <blink/graph/dijkstra_object.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+typedef boost::property<boost::edge_weight_t, double> edge_prop;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+  boost::no_property, edge_prop> graph_type;
+typedef boost::graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+typedef std::vector<vertex_descriptor> source_range_type;
+
+typedef blink::one_control_point_vector<blink::cp_examine_edge>::type
+  examine_edge_type;
+
+graph_type make_random_graph(std::size_t n, std::size_t degree)
+{
+  boost::random::mt19937 rng(1);
+  boost::random::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  boost::random::uniform_real_distribution<double> weight(0.0, 10.0);
+  graph_type g(n);
+  for (std::size_t i = 0; i < n * degree; ++i) {
+    boost::add_edge(vertex(rng), vertex(rng), weight(rng), g);
+  }
+  return g;
+}
+
+struct result
+{
+  std::size_t events;
+  double checksum;
+  double seconds;
+};
+
+template<typename ControlMap>
+result run_object(const graph_type& g, const source_range_type& sources)
+{
+  typedef typename blink::dijkstra_object_helper<graph_type,
+    const source_range_type, ControlMap, boost::no_named_parameters>::type
+    dijkstra_type;
+  dijkstra_type dijkstra = blink::make_dijkstra_object(g, sources,
+    ControlMap());
+
+  const std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  result r = { 0, 0.0, 0.0 };
+  while (dijkstra()) {
+    ++r.events;
+    r.checksum += dijkstra.get_u();
+  }
+  r.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  return r;
+}
+
+template<typename ControlMap>
+result run_object_fill(const graph_type& g, const source_range_type& sources)
+{
+  typedef typename blink::dijkstra_object_helper<graph_type,
+    const source_range_type, ControlMap, boost::no_named_parameters>::type
+    dijkstra_type;
+  dijkstra_type dijkstra = blink::make_dijkstra_object(g, sources,
+    ControlMap());
+  std::vector<typename dijkstra_type::event_type> buffer(256);
+
+  const std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  result r = { 0, 0.0, 0.0 };
+  std::size_t n = buffer.size();
+  while (n == buffer.size()) {
+    n = dijkstra.fill(&buffer[0], &buffer[0] + buffer.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      r.checksum += buffer[i].u;
+    }
+    r.events += n;
+  }
+  r.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  return r;
+}
+
+template<typename ControlMap>
+result run_generator(const graph_type& g, const source_range_type& sources)
+{
+  typedef typename blink::dijkstra_generator_helper<graph_type,
+    source_range_type, ControlMap, boost::no_named_parameters>::type
+    dijkstra_type;
+  dijkstra_type dijkstra = blink::make_dijkstra_generator(g, sources,
+    ControlMap());
+
+  const std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  result r = { 0, 0.0, 0.0 };
+  for (const typename dijkstra_type::event_type& event : dijkstra.events()) {
+    ++r.events;
+    r.checksum += event.u;
+  }
+  r.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  return r;
+}
+
+void report(const char* name, const result& r)
+{
+  std::cout << name << '\t' << r.events << '\t' << r.seconds << '\t'
+    << 1e9 * r.seconds / r.events << '\t' << r.checksum << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  const std::size_t degree = argc > 2 ? std::atoi(argv[2]) : 4;
+  const graph_type g = make_random_graph(n, degree);
+  const source_range_type sources(1, 0);
+
+  std::cout << "run\tevents\tseconds\tns/event\tchecksum" << std::endl;
+  report("object, finish_vertex",
+    run_object<blink::only_finish_vertex_type>(g, sources));
+  report("object fill, finish_vertex",
+    run_object_fill<blink::only_finish_vertex_type>(g, sources));
+  report("generator, finish_vertex",
+    run_generator<blink::only_finish_vertex_type>(g, sources));
+  report("object, examine_edge",
+    run_object<examine_edge_type>(g, sources));
+  report("object fill, examine_edge",
+    run_object_fill<examine_edge_type>(g, sources));
+  report("generator, examine_edge",
+    run_generator<examine_edge_type>(g, sources));
+  return 0;
+}
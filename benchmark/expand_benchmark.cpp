@@ -0,0 +1,178 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Runs exhaustive expand_for() searches from random sources on a random
+// graph, with the hardware counters of perf_counters.hpp around each
+// expansion. The results are written as JSON, per run and normalized per
+// settled vertex and per scanned edge.
+// Counters that are not available (e.g. in a container without
+// perf_event access) are left out, the timings are always reported.
+//
+// usage: expand_benchmark [num_vertices] [out_degree] [runs] [json_file]
+//
+//=======================================================================
+//
+#include "perf_counters.hpp"
+
+#include <blink/graph/expand_for.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+typedef boost::property<boost::edge_weight_t, double> edge_prop;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+  boost::no_property, edge_prop> graph_type;
+typedef boost::graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+
+graph_type make_random_graph(std::size_t n, std::size_t degree)
+{
+  boost::random::mt19937 rng(1);
+  boost::random::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  boost::random::uniform_real_distribution<double> weight(0.0, 10.0);
+  graph_type g(n);
+  for (std::size_t i = 0; i < n * degree; ++i) {
+    boost::add_edge(vertex(rng), vertex(rng), weight(rng), g);
+  }
+  return g;
+}
+
+struct run_result
+{
+  vertex_descriptor source;
+  double seconds;
+  std::size_t vertices_settled;
+  std::size_t edges_scanned;
+  std::vector<double> counters; // in the order of perf_counters::counters()
+};
+
+double per(double value, std::size_t n)
+{
+  return n == 0 ? 0.0 : value / static_cast<double>(n);
+}
+
+void write_counters(std::ostream& os, const blink::perf_counters& perf,
+  const std::vector<double>& values, std::size_t vertices, std::size_t edges)
+{
+  os << "{";
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    os << (i == 0 ? "" : ", ") << "\"" << perf.counters()[i].name
+      << "\": {\"value\": " << values[i]
+      << ", \"per_vertex\": " << per(values[i], vertices)
+      << ", \"per_edge\": " << per(values[i], edges) << "}";
+  }
+  os << "}";
+}
+
+void write_json(std::ostream& os, std::size_t num_vertices,
+  std::size_t degree, const blink::perf_counters& perf,
+  const std::vector<run_result>& runs)
+{
+  run_result total = { 0, 0.0, 0, 0,
+    std::vector<double>(perf.counters().size(), 0.0) };
+  for (std::size_t r = 0; r < runs.size(); ++r) {
+    total.seconds += runs[r].seconds;
+    total.vertices_settled += runs[r].vertices_settled;
+    total.edges_scanned += runs[r].edges_scanned;
+    for (std::size_t i = 0; i < total.counters.size(); ++i) {
+      total.counters[i] += runs[r].counters[i];
+    }
+  }
+
+  os << "{\n  \"num_vertices\": " << num_vertices
+    << ",\n  \"out_degree\": " << degree
+    << ",\n  \"counters_available\": [";
+  for (std::size_t i = 0; i < perf.counters().size(); ++i) {
+    os << (i == 0 ? "" : ", ") << "\"" << perf.counters()[i].name << "\"";
+  }
+  os << "],\n  \"runs\": [";
+  for (std::size_t r = 0; r < runs.size(); ++r) {
+    os << (r == 0 ? "\n" : ",\n") << "    {\"source\": " << runs[r].source
+      << ", \"seconds\": " << runs[r].seconds
+      << ", \"vertices_settled\": " << runs[r].vertices_settled
+      << ", \"edges_scanned\": " << runs[r].edges_scanned
+      << ", \"counters\": ";
+    write_counters(os, perf, runs[r].counters, runs[r].vertices_settled,
+      runs[r].edges_scanned);
+    os << "}";
+  }
+  os << "\n  ],\n  \"total\": {\"seconds\": " << total.seconds
+    << ", \"vertices_settled\": " << total.vertices_settled
+    << ", \"edges_scanned\": " << total.edges_scanned
+    << ", \"ns_per_vertex\": " << per(total.seconds * 1e9,
+      total.vertices_settled)
+    << ", \"ns_per_edge\": " << per(total.seconds * 1e9, total.edges_scanned)
+    << ", \"counters\": ";
+  write_counters(os, perf, total.counters, total.vertices_settled,
+    total.edges_scanned);
+  os << "}\n}\n";
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  const std::size_t degree = argc > 2 ? std::atoi(argv[2]) : 4;
+  const std::size_t num_runs = argc > 3 ? std::atoi(argv[3]) : 5;
+  const std::string json_file = argc > 4 ? argv[4] : "";
+
+  const graph_type g = make_random_graph(n, degree);
+  blink::perf_counters perf;
+  if (!perf.available()) {
+    std::cerr << "no hardware counters available, reporting timings only"
+      << std::endl;
+  }
+
+  typedef blink::resumable_dijkstra_helper<graph_type,
+    boost::no_named_parameters>::type dijkstra_type;
+  dijkstra_type dijkstra = blink::make_resumable_dijkstra(g);
+
+  boost::random::mt19937 rng(2);
+  boost::random::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::vector<run_result> runs;
+  for (std::size_t r = 0; r < num_runs; ++r) {
+    const vertex_descriptor source = vertex(rng);
+    dijkstra.init_from_source(source);
+
+    const std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+    perf.start();
+    const blink::expand_statistics<double> statistics
+      = blink::expand_for(dijkstra, std::size_t(-1));
+    perf.stop();
+    const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+    run_result result = { source, seconds, statistics.vertices_settled,
+      statistics.edges_scanned, std::vector<double>() };
+    for (std::size_t i = 0; i < perf.counters().size(); ++i) {
+      result.counters.push_back(perf.counters()[i].value);
+    }
+    runs.push_back(result);
+  }
+
+  if (json_file.empty()) {
+    write_json(std::cout, n, degree, perf, runs);
+  } else {
+    std::ofstream os(json_file.c_str());
+    write_json(os, n, degree, perf, runs);
+  }
+  return 0;
+}
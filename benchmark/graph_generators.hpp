@@ -0,0 +1,246 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Reproducible synthetic graphs for the benchmarks. All generators take a
+// seed and give the same graph for the same seed on every platform, as
+// they only use boost::random. Graphs must be mutable with an edge_weight
+// property, edges are added with add_edge(u, v, weight, g).
+//
+//   make_grid_2d_graph    4-neighbour grid, both directions, random weights
+//   make_grid_3d_graph    6-neighbour grid, both directions, random weights
+//   make_geometric_graph  random points in the unit square, connected
+//                         within a radius, weights are euclidean distances
+//   make_rmat_graph       R-MAT (Kronecker) graph with 2^scale vertices,
+//                         directed, random weights, permuted vertex labels
+//   make_road_graph       planar road-like graph: a jittered grid with
+//                         edges removed, some diagonals and faster roads
+//                         on every k-th row and column
+//
+//=======================================================================
+//
+
+#ifndef BLINK_BENCHMARK_GRAPH_GENERATORS_HPP
+#define BLINK_BENCHMARK_GRAPH_GENERATORS_HPP
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/random/bernoulli_distribution.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace blink {
+
+namespace detail {
+
+  template<typename Graph>
+  void add_edge_pair(std::size_t u, std::size_t v, double weight, Graph& g)
+  {
+    add_edge(vertex(u, g), vertex(v, g), weight, g);
+    add_edge(vertex(v, g), vertex(u, g), weight, g);
+  }
+
+  inline double euclidean(const std::pair<double, double>& a,
+    const std::pair<double, double>& b)
+  {
+    const double dx = a.first - b.first;
+    const double dy = a.second - b.second;
+    return std::sqrt(dx * dx + dy * dy);
+  }
+
+} // namespace detail
+
+template<typename Graph>
+Graph make_grid_2d_graph(std::size_t width, std::size_t height,
+  unsigned int seed)
+{
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<double> weight(1.0, 10.0);
+  Graph g(width * height);
+  for (std::size_t y = 0; y < height; ++y) {
+    for (std::size_t x = 0; x < width; ++x) {
+      const std::size_t u = y * width + x;
+      if (x + 1 < width) detail::add_edge_pair(u, u + 1, weight(rng), g);
+      if (y + 1 < height) detail::add_edge_pair(u, u + width, weight(rng), g);
+    }
+  }
+  return g;
+}
+
+template<typename Graph>
+Graph make_grid_3d_graph(std::size_t width, std::size_t height,
+  std::size_t depth, unsigned int seed)
+{
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<double> weight(1.0, 10.0);
+  const std::size_t layer = width * height;
+  Graph g(layer * depth);
+  for (std::size_t z = 0; z < depth; ++z) {
+    for (std::size_t y = 0; y < height; ++y) {
+      for (std::size_t x = 0; x < width; ++x) {
+        const std::size_t u = z * layer + y * width + x;
+        if (x + 1 < width) detail::add_edge_pair(u, u + 1, weight(rng), g);
+        if (y + 1 < height) {
+          detail::add_edge_pair(u, u + width, weight(rng), g);
+        }
+        if (z + 1 < depth) detail::add_edge_pair(u, u + layer, weight(rng), g);
+      }
+    }
+  }
+  return g;
+}
+
+// The radius gives on average degree neighbours, points are bucketed in
+// cells of the size of the radius, so that only neighbouring cells are
+// compared.
+template<typename Graph>
+Graph make_geometric_graph(std::size_t n, double degree, unsigned int seed)
+{
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<double> coordinate(0.0, 1.0);
+  const double pi = 3.14159265358979323846;
+  const double radius = std::sqrt(degree / (pi * n));
+  const std::size_t cells = std::max<std::size_t>(1,
+    static_cast<std::size_t>(1.0 / radius));
+
+  std::vector<std::pair<double, double> > points(n);
+  std::vector<std::vector<std::size_t> > buckets(cells * cells);
+  for (std::size_t i = 0; i < n; ++i) {
+    points[i].first = coordinate(rng);
+    points[i].second = coordinate(rng);
+    const std::size_t cx = std::min(cells - 1,
+      static_cast<std::size_t>(points[i].first * cells));
+    const std::size_t cy = std::min(cells - 1,
+      static_cast<std::size_t>(points[i].second * cells));
+    buckets[cy * cells + cx].push_back(i);
+  }
+
+  // this cell and the neighbours to the right and below, so that every
+  // pair of cells is compared once
+  const int offsets[5][2] = { {0, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1} };
+  Graph g(n);
+  for (std::size_t cy = 0; cy < cells; ++cy) {
+    for (std::size_t cx = 0; cx < cells; ++cx) {
+      const std::vector<std::size_t>& here = buckets[cy * cells + cx];
+      for (int k = 0; k < 5; ++k) {
+        const std::size_t nx = cx + offsets[k][0];
+        const std::size_t ny = cy + offsets[k][1];
+        if (nx >= cells || ny >= cells) continue; // wraps for cx == 0
+        const std::vector<std::size_t>& there = buckets[ny * cells + nx];
+        for (std::size_t i = 0; i < here.size(); ++i) {
+          const std::size_t first = k == 0 ? i + 1 : 0;
+          for (std::size_t j = first; j < there.size(); ++j) {
+            const double d = detail::euclidean(points[here[i]],
+              points[there[j]]);
+            if (d <= radius) detail::add_edge_pair(here[i], there[j], d, g);
+          }
+        }
+      }
+    }
+  }
+  return g;
+}
+
+// The Graph500 parameters are a = 0.57, b = 0.19, c = 0.19
+template<typename Graph>
+Graph make_rmat_graph(std::size_t scale, std::size_t edge_factor,
+  unsigned int seed, double a = 0.57, double b = 0.19, double c = 0.19)
+{
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<double> quadrant(0.0, 1.0);
+  boost::random::uniform_real_distribution<double> weight(0.0, 1.0);
+  const std::size_t n = std::size_t(1) << scale;
+
+  // a random permutation of the labels, so that the high degree vertices
+  // are not all at the front
+  std::vector<std::size_t> label(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    label[i] = i;
+  }
+  for (std::size_t i = n - 1; i > 0; --i) {
+    boost::random::uniform_int_distribution<std::size_t> pick(0, i);
+    std::swap(label[i], label[pick(rng)]);
+  }
+
+  Graph g(n);
+  for (std::size_t e = 0; e < n * edge_factor; ++e) {
+    std::size_t u = 0;
+    std::size_t v = 0;
+    for (std::size_t bit = 0; bit < scale; ++bit) {
+      const double p = quadrant(rng);
+      u = (u << 1) | (p >= a + b ? 1 : 0);
+      v = (v << 1) | ((p >= a && p < a + b) || p >= a + b + c ? 1 : 0);
+    }
+    add_edge(vertex(label[u], g), vertex(label[v], g), weight(rng), g);
+  }
+  return g;
+}
+
+// Vertices are on a grid, moved up to a third of the spacing. A quarter of
+// the grid edges is removed, except on every highway-th row and column,
+// where the roads are twice as fast. Some cells get one diagonal, so the
+// graph remains planar. Weights are the length divided by the speed.
+template<typename Graph>
+Graph make_road_graph(std::size_t width, std::size_t height,
+  unsigned int seed, std::size_t highway = 16)
+{
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<double> jitter(-1.0 / 3, 1.0 / 3);
+  boost::random::uniform_real_distribution<double> speed(0.5, 1.0);
+  boost::random::bernoulli_distribution<double> keep(0.75);
+  boost::random::bernoulli_distribution<double> diagonal(0.2);
+  boost::random::bernoulli_distribution<double> orientation(0.5);
+
+  std::vector<std::pair<double, double> > points(width * height);
+  for (std::size_t y = 0; y < height; ++y) {
+    for (std::size_t x = 0; x < width; ++x) {
+      points[y * width + x] = std::make_pair(x + jitter(rng), y + jitter(rng));
+    }
+  }
+
+  Graph g(width * height);
+  for (std::size_t y = 0; y < height; ++y) {
+    for (std::size_t x = 0; x < width; ++x) {
+      const std::size_t u = y * width + x;
+      if (x + 1 < width) {
+        const bool is_highway = y % highway == 0;
+        if (is_highway || keep(rng)) {
+          const double s = is_highway ? 2.0 : speed(rng);
+          detail::add_edge_pair(u, u + 1,
+            detail::euclidean(points[u], points[u + 1]) / s, g);
+        }
+      }
+      if (y + 1 < height) {
+        const bool is_highway = x % highway == 0;
+        if (is_highway || keep(rng)) {
+          const double s = is_highway ? 2.0 : speed(rng);
+          detail::add_edge_pair(u, u + width,
+            detail::euclidean(points[u], points[u + width]) / s, g);
+        }
+      }
+      if (x + 1 < width && y + 1 < height && diagonal(rng)) {
+        const std::size_t from = orientation(rng) ? u : u + 1;
+        const std::size_t to = from == u ? u + width + 1 : u + width;
+        detail::add_edge_pair(from, to,
+          detail::euclidean(points[from], points[to]) / speed(rng), g);
+      }
+    }
+  }
+  return g;
+}
+
+} // namespace blink
+
+#endif // BLINK_BENCHMARK_GRAPH_GENERATORS_HPP
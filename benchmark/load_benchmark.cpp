@@ -0,0 +1,148 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Times loading a DIMACS .gr file (e.g. USA-road-d.USA.gr) into a
+// flat_graph with one and with num_threads threads, writing and reading
+// it as binary edge list, and for comparison building an adjacency_list
+// with add_edge from the same arcs. Both graphs are searched from vertex 0
+// to check that they give the same distances.
+//
+// usage: load_benchmark graph.gr [num_threads] [edge_list_file]
+//
+//=======================================================================
+//
+#include <blink/graph/flat_graph.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+typedef blink::flat_edge_list<double> edge_list_type;
+typedef blink::flat_graph<double>::type flat_graph_type;
+
+typedef boost::property<boost::edge_weight_t, double> edge_prop;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+  boost::no_property, edge_prop> adjacency_list_type;
+
+class stopwatch
+{
+public:
+  stopwatch() : m_start(std::chrono::steady_clock::now())
+  {}
+
+  double seconds() const
+  {
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - m_start).count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point m_start;
+};
+
+void report(const char* name, double seconds)
+{
+  std::cout << name << '\t' << seconds << std::endl;
+}
+
+template<typename Graph>
+std::vector<double> distances_from_first(const Graph& g)
+{
+  typedef typename blink::resumable_dijkstra_helper<Graph,
+    boost::no_named_parameters>::type dijkstra_type;
+  dijkstra_type dijkstra = blink::make_resumable_dijkstra(g);
+  dijkstra.init_from_source(vertex(0, g));
+  dijkstra.expand();
+  typename dijkstra_type::template param<boost::vertex_distance_t>::type
+    distance = dijkstra.get(boost::vertex_distance_t());
+  std::vector<double> result(num_vertices(g));
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    result[i] = get(distance, vertex(i, g));
+  }
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    std::cerr << "usage: load_benchmark graph.gr [num_threads] "
+      "[edge_list_file]" << std::endl;
+    return 2;
+  }
+  const std::string gr_file = argv[1];
+  const std::size_t hardware = std::thread::hardware_concurrency();
+  const std::size_t num_threads = argc > 2 ? std::atoi(argv[2])
+    : hardware == 0 ? 1 : hardware;
+  const std::string edge_list_file = argc > 3 ? argv[3] : "";
+
+  std::cout << "step\tseconds" << std::endl;
+  {
+    edge_list_type edges;
+    const stopwatch watch;
+    blink::read_dimacs_graph(gr_file, edges, 1);
+    report("read_dimacs_graph, 1 thread", watch.seconds());
+  }
+
+  edge_list_type edges;
+  {
+    const stopwatch watch;
+    blink::read_dimacs_graph(gr_file, edges, num_threads);
+    report("read_dimacs_graph, num_threads", watch.seconds());
+  }
+  std::cerr << edges.num_vertices << " vertices, " << edges.sources.size()
+    << " arcs, " << num_threads << " threads" << std::endl;
+
+  if (!edge_list_file.empty()) {
+    {
+      const stopwatch watch;
+      std::ofstream os(edge_list_file.c_str(), std::ios::binary);
+      blink::write_edge_list(os, edges);
+      report("write_edge_list", watch.seconds());
+    }
+    edge_list_type reread;
+    const stopwatch watch;
+    blink::read_edge_list(edge_list_file, reread);
+    report("read_edge_list", watch.seconds());
+  }
+
+  stopwatch flat_watch;
+  const flat_graph_type flat = blink::make_flat_graph(edges);
+  report("make_flat_graph", flat_watch.seconds());
+
+  stopwatch adjacency_watch;
+  adjacency_list_type adjacency(edges.num_vertices);
+  for (std::size_t i = 0; i < edges.sources.size(); ++i) {
+    boost::add_edge(edges.sources[i], edges.targets[i], edges.weights[i],
+      adjacency);
+  }
+  report("adjacency_list with add_edge", adjacency_watch.seconds());
+
+  stopwatch flat_search;
+  const std::vector<double> flat_distance = distances_from_first(flat);
+  report("dijkstra on flat_graph", flat_search.seconds());
+
+  stopwatch adjacency_search;
+  const std::vector<double> adjacency_distance
+    = distances_from_first(adjacency);
+  report("dijkstra on adjacency_list", adjacency_search.seconds());
+
+  if (flat_distance != adjacency_distance) {
+    std::cerr << "the distances differ" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,150 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Hardware performance counters for the benchmarks, using Linux
+// perf_event_open for the calling thread: cycles, instructions, branch
+// misses and L1d, LLC and dTLB read misses. Each counter is opened on its
+// own, so counters that the kernel, the CPU or the container does not
+// provide are left out and the others still count. On other platforms no
+// counter is available. Multiplexed counters are scaled to the full time.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_BENCHMARK_PERF_COUNTERS_HPP
+#define BLINK_BENCHMARK_PERF_COUNTERS_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace blink {
+
+class perf_counters : boost::noncopyable
+{
+public:
+  struct counter
+  {
+    std::string name;
+    int fd;
+    double value; // of the last start() - stop()
+  };
+
+  perf_counters()
+  {
+#ifdef __linux__
+    open_counter("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    open_counter("instructions", PERF_TYPE_HARDWARE,
+      PERF_COUNT_HW_INSTRUCTIONS);
+    open_counter("branch_misses", PERF_TYPE_HARDWARE,
+      PERF_COUNT_HW_BRANCH_MISSES);
+    open_counter("l1d_misses", PERF_TYPE_HW_CACHE,
+      cache_miss(PERF_COUNT_HW_CACHE_L1D));
+    open_counter("llc_misses", PERF_TYPE_HW_CACHE,
+      cache_miss(PERF_COUNT_HW_CACHE_LL));
+    open_counter("dtlb_misses", PERF_TYPE_HW_CACHE,
+      cache_miss(PERF_COUNT_HW_CACHE_DTLB));
+#endif
+  }
+
+  ~perf_counters()
+  {
+#ifdef __linux__
+    for (std::size_t i = 0; i < m_counters.size(); ++i) {
+      ::close(m_counters[i].fd);
+    }
+#endif
+  }
+
+  // The counters that could be opened
+  const std::vector<counter>& counters() const
+  {
+    return m_counters;
+  }
+
+  bool available() const
+  {
+    return !m_counters.empty();
+  }
+
+  void start()
+  {
+#ifdef __linux__
+    for (std::size_t i = 0; i < m_counters.size(); ++i) {
+      ::ioctl(m_counters[i].fd, PERF_EVENT_IOC_RESET, 0);
+      ::ioctl(m_counters[i].fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  void stop()
+  {
+#ifdef __linux__
+    for (std::size_t i = 0; i < m_counters.size(); ++i) {
+      ::ioctl(m_counters[i].fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (std::size_t i = 0; i < m_counters.size(); ++i) {
+      std::uint64_t data[3] = { 0, 0, 0 }; // value, enabled, running
+      m_counters[i].value = 0.0;
+      if (::read(m_counters[i].fd, data, sizeof(data)) == sizeof(data)
+        && data[2] > 0) {
+        m_counters[i].value = static_cast<double>(data[0])
+          * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+      }
+    }
+#endif
+  }
+
+private:
+#ifdef __linux__
+  static std::uint64_t cache_miss(std::uint64_t cache)
+  {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+      | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  }
+
+  void open_counter(const char* name, std::uint32_t type, std::uint64_t config)
+  {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+      | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    const int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0,
+      -1, -1, 0));
+    if (fd >= 0) {
+      counter c = { name, fd, 0.0 };
+      m_counters.push_back(c);
+    }
+  }
+#endif
+
+  std::vector<counter> m_counters;
+};
+
+} // namespace blink
+
+#endif // BLINK_BENCHMARK_PERF_COUNTERS_HPP
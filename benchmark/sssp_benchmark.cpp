@@ -0,0 +1,351 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Shortest path benchmark suite on the synthetic graphs of
+// graph_generators.hpp: 2D and 3D grids, a random geometric graph, an
+// R-MAT graph and a road-like graph, all of about num_vertices vertices.
+//
+// On every graph, from the same random sources, it times
+// boost::dijkstra_shortest_paths, the convenience functions
+// dijkstra_shortest_path_plain, _targets, _distance and _nearest_source,
+// and dijkstra_object with three control maps. Every measurement is the
+// minimum and median over the repeats. The checksum is the sum of the
+// finite distances (or of the vertices of the events) that each run
+// reaches, "plain_agrees" tells whether the distances of the plain search
+// are those of boost. The results are written as JSON, so that releases
+// can be compared.
+//
+// usage: sssp_benchmark [num_vertices] [repeats] [json_file]
+//
+//=======================================================================
+//
+#include "graph_generators.hpp"
+
+#include <blink/graph/dijkstra_control.hpp>
+#include <blink/graph/dijkstra_functions.hpp>
+#include <blink/graph/dijkstra_object.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+typedef boost::property<boost::edge_weight_t, double> edge_prop;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+  boost::no_property, edge_prop> graph_type;
+typedef boost::graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+typedef std::vector<vertex_descriptor> vertex_range_type;
+
+typedef blink::one_control_point_vector<blink::cp_examine_edge>::type
+  examine_edge_type;
+
+struct workload
+{
+  std::string name;
+  graph_type graph;
+  vertex_range_type sources;       // one search per source, not sinks
+  vertex_range_type targets;       // for dijkstra_shortest_path_targets
+  std::vector<double> reference;   // distances from sources[0], by boost
+  double target_distance;          // half the eccentricity of sources[0]
+  bool plain_agrees;
+};
+
+struct measurement
+{
+  std::string name;
+  double min_seconds;
+  double median_seconds;
+  double checksum;
+};
+
+// The sum of the finite distances
+template<typename DistanceMap>
+double sum_of_distances(const graph_type& g, DistanceMap distance)
+{
+  double sum = 0.0;
+  for (std::size_t i = 0; i < num_vertices(g); ++i) {
+    const double d = get(distance, vertex(i, g));
+    if (d < std::numeric_limits<double>::max()) sum += d;
+  }
+  return sum;
+}
+
+//
+// The runs, one search from one source, returning the checksum
+//
+
+struct run_boost
+{
+  double operator()(const workload& w, vertex_descriptor source) const
+  {
+    std::vector<double> distance(num_vertices(w.graph));
+    std::vector<vertex_descriptor> predecessor(num_vertices(w.graph));
+    boost::dijkstra_shortest_paths(w.graph, source,
+      boost::distance_map(&distance[0]).predecessor_map(&predecessor[0]));
+    return sum_of_distances(w.graph, &distance[0]);
+  }
+};
+
+struct run_plain
+{
+  double operator()(const workload& w, vertex_descriptor source) const
+  {
+    typedef blink::dijkstra_state_helper<graph_type,
+      boost::no_named_parameters>::type state_type;
+    state_type state = blink::dijkstra_shortest_path_plain(w.graph, source);
+    return sum_of_distances(w.graph, state.get<boost::vertex_distance_t>());
+  }
+};
+
+struct run_targets
+{
+  double operator()(const workload& w, vertex_descriptor source) const
+  {
+    typedef blink::dijkstra_state_helper<graph_type,
+      boost::no_named_parameters>::type state_type;
+    typedef blink::target_helper<state_type>::visitor_type visitor_type;
+    std::pair<state_type, visitor_type> result
+      = blink::dijkstra_shortest_path_targets(w.graph, source, w.targets);
+    state_type::param<boost::vertex_distance_t>::type distance
+      = result.first.get<boost::vertex_distance_t>();
+    double sum = 0.0;
+    for (std::size_t i = 0; i < w.targets.size(); ++i) {
+      const double d = get(distance, w.targets[i]);
+      if (d < std::numeric_limits<double>::max()) sum += d;
+    }
+    return sum;
+  }
+};
+
+struct run_distance
+{
+  double operator()(const workload& w, vertex_descriptor source) const
+  {
+    typedef blink::dijkstra_state_helper<graph_type,
+      boost::no_named_parameters>::type state_type;
+    typedef blink::distance_visitor_helper<state_type>::type visitor_type;
+    std::pair<state_type, visitor_type> result
+      = blink::dijkstra_shortest_path_distance(w.graph, source,
+        w.target_distance);
+    return sum_of_distances(w.graph,
+      result.first.get<boost::vertex_distance_t>());
+  }
+};
+
+// All sources at once, so it is only run for the first source
+struct run_nearest_source
+{
+  double operator()(const workload& w, vertex_descriptor) const
+  {
+    typedef blink::dijkstra_state_helper<graph_type,
+      boost::no_named_parameters>::type state_type;
+    typedef blink::nearest_source_helper<state_type>::visitor_type
+      visitor_type;
+    std::pair<state_type, visitor_type> result
+      = blink::dijkstra_shortest_path_nearest_source(w.graph, w.sources);
+    return sum_of_distances(w.graph,
+      result.first.get<boost::vertex_distance_t>());
+  }
+};
+
+template<typename ControlMap>
+struct run_object
+{
+  double operator()(const workload& w, vertex_descriptor source) const
+  {
+    typedef typename blink::dijkstra_object_helper<graph_type,
+      const vertex_range_type, ControlMap, boost::no_named_parameters>::type
+      dijkstra_type;
+    const vertex_range_type sources(1, source);
+    dijkstra_type dijkstra = blink::make_dijkstra_object(w.graph, sources,
+      ControlMap());
+    double sum = 0.0;
+    while (dijkstra()) {
+      sum += dijkstra.get_u();
+    }
+    return sum;
+  }
+};
+
+template<typename Run>
+measurement measure(const std::string& name, const workload& w,
+  std::size_t repeats, bool all_sources, Run run)
+{
+  const std::size_t num_sources = all_sources ? w.sources.size() : 1;
+  std::vector<double> seconds;
+  measurement m = { name, 0.0, 0.0, 0.0 };
+  for (std::size_t r = 0; r < repeats; ++r) {
+    const std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+    for (std::size_t i = 0; i < num_sources; ++i) {
+      checksum += run(w, w.sources[i]);
+    }
+    seconds.push_back(std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count());
+    m.checksum = checksum;
+  }
+  std::sort(seconds.begin(), seconds.end());
+  m.min_seconds = seconds.front();
+  m.median_seconds = seconds[seconds.size() / 2];
+  return m;
+}
+
+// The distances of dijkstra_shortest_path_plain are those of boost
+bool plain_agrees(const workload& w)
+{
+  typedef blink::dijkstra_state_helper<graph_type,
+    boost::no_named_parameters>::type state_type;
+  state_type state = blink::dijkstra_shortest_path_plain(w.graph,
+    w.sources[0]);
+  state_type::param<boost::vertex_distance_t>::type distance
+    = state.get<boost::vertex_distance_t>();
+  for (std::size_t i = 0; i < w.reference.size(); ++i) {
+    if (get(distance, vertex(i, w.graph)) != w.reference[i]) return false;
+  }
+  return true;
+}
+
+workload make_workload(const std::string& name, const graph_type& g,
+  std::size_t num_sources, std::size_t num_targets, unsigned int seed)
+{
+  workload w;
+  w.name = name;
+  w.graph = g;
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_int_distribution<std::size_t> pick(0,
+    num_vertices(g) - 1);
+  while (w.sources.size() < num_sources) {
+    const vertex_descriptor source = vertex(pick(rng), g);
+    if (out_degree(source, g) > 0) w.sources.push_back(source);
+  }
+  for (std::size_t i = 0; i < num_targets; ++i) {
+    w.targets.push_back(vertex(pick(rng), g));
+  }
+
+  w.reference.resize(num_vertices(g));
+  boost::dijkstra_shortest_paths(g, w.sources[0],
+    boost::distance_map(&w.reference[0]));
+  double eccentricity = 0.0;
+  for (std::size_t i = 0; i < w.reference.size(); ++i) {
+    if (w.reference[i] < std::numeric_limits<double>::max()) {
+      eccentricity = std::max(eccentricity, w.reference[i]);
+    }
+  }
+  w.target_distance = eccentricity / 2;
+  w.plain_agrees = plain_agrees(w);
+  return w;
+}
+
+std::vector<measurement> run_workload(const workload& w, std::size_t repeats)
+{
+  std::vector<measurement> m;
+  m.push_back(measure("boost_dijkstra", w, repeats, true, run_boost()));
+  m.push_back(measure("plain", w, repeats, true, run_plain()));
+  m.push_back(measure("targets", w, repeats, true, run_targets()));
+  m.push_back(measure("distance", w, repeats, true, run_distance()));
+  m.push_back(measure("nearest_source", w, repeats, false,
+    run_nearest_source()));
+  m.push_back(measure("object_finish_vertex", w, repeats, true,
+    run_object<blink::only_finish_vertex_type>()));
+  m.push_back(measure("object_examine_edge", w, repeats, true,
+    run_object<examine_edge_type>()));
+  m.push_back(measure("object_all_control_points", w, repeats, true,
+    run_object<blink::all_control_points_type>()));
+  return m;
+}
+
+void write_json(std::ostream& os, std::size_t repeats,
+  const std::vector<workload>& workloads,
+  const std::vector<std::vector<measurement> >& results)
+{
+  os.precision(std::numeric_limits<double>::digits10);
+  os << "{\n  \"repeats\": " << repeats << ",\n  \"graphs\": [";
+  for (std::size_t i = 0; i < workloads.size(); ++i) {
+    const workload& w = workloads[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << w.name
+      << "\", \"vertices\": " << num_vertices(w.graph)
+      << ", \"edges\": " << num_edges(w.graph)
+      << ", \"sources\": " << w.sources.size()
+      << ", \"targets\": " << w.targets.size()
+      << ", \"target_distance\": " << w.target_distance
+      << ", \"plain_agrees\": " << (w.plain_agrees ? "true" : "false")
+      << ",\n     \"runs\": [";
+    for (std::size_t j = 0; j < results[i].size(); ++j) {
+      const measurement& m = results[i][j];
+      os << (j == 0 ? "\n" : ",\n") << "       {\"name\": \"" << m.name
+        << "\", \"min_seconds\": " << m.min_seconds
+        << ", \"median_seconds\": " << m.median_seconds
+        << ", \"checksum\": " << m.checksum << "}";
+    }
+    os << "\n     ]}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t n = argc > 1 ? std::atoi(argv[1]) : 1 << 18;
+  const std::size_t repeats = argc > 2 ? std::atoi(argv[2]) : 3;
+  const std::string json_file = argc > 3 ? argv[3] : "";
+  const std::size_t num_sources = 4;
+  const std::size_t num_targets = 16;
+
+  const std::size_t side_2d = static_cast<std::size_t>(std::sqrt(double(n)));
+  const std::size_t side_3d = static_cast<std::size_t>(
+    std::pow(double(n), 1.0 / 3) + 0.5);
+  std::size_t scale = 1;
+  while ((std::size_t(2) << scale) <= n) ++scale;
+
+  std::vector<workload> workloads;
+  workloads.push_back(make_workload("grid_2d",
+    blink::make_grid_2d_graph<graph_type>(side_2d, side_2d, 1),
+    num_sources, num_targets, 11));
+  workloads.push_back(make_workload("grid_3d",
+    blink::make_grid_3d_graph<graph_type>(side_3d, side_3d, side_3d, 2),
+    num_sources, num_targets, 12));
+  workloads.push_back(make_workload("geometric",
+    blink::make_geometric_graph<graph_type>(n, 6.0, 3),
+    num_sources, num_targets, 13));
+  workloads.push_back(make_workload("rmat",
+    blink::make_rmat_graph<graph_type>(scale, 8, 4),
+    num_sources, num_targets, 14));
+  workloads.push_back(make_workload("road",
+    blink::make_road_graph<graph_type>(side_2d, side_2d, 5),
+    num_sources, num_targets, 15));
+
+  std::vector<std::vector<measurement> > results;
+  for (std::size_t i = 0; i < workloads.size(); ++i) {
+    std::cerr << workloads[i].name << ": " << num_vertices(workloads[i].graph)
+      << " vertices, " << num_edges(workloads[i].graph) << " edges"
+      << std::endl;
+    results.push_back(run_workload(workloads[i], repeats));
+  }
+
+  if (json_file.empty()) {
+    write_json(std::cout, repeats, workloads, results);
+  } else {
+    std::ofstream os(json_file.c_str());
+    write_json(os, repeats, workloads, results);
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Times an exhaustive search on a random graph without a visitor, with a
+// trace_visitor and with a logging_visitor writing to a file. The trace
+// is written to trace_file for tools/trace_decoder.
+//
+// usage: trace_benchmark [num_vertices] [out_degree] [trace_file]
+//   [log_file]
+//
+//=======================================================================
+//
+#include <blink/graph/dijkstra_visitor/logging_visitor.hpp>
+#include <blink/graph/dijkstra_visitor/trace_visitor.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef boost::property<boost::edge_weight_t, double> edge_prop;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+  boost::no_property, edge_prop> graph_type;
+typedef blink::resumable_dijkstra_helper<graph_type,
+  boost::no_named_parameters>::type dijkstra_type;
+typedef boost::property_map<graph_type, boost::vertex_index_t>::const_type
+  index_map_type;
+
+graph_type make_random_graph(std::size_t n, std::size_t degree)
+{
+  boost::random::mt19937 rng(1);
+  boost::random::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  boost::random::uniform_real_distribution<double> weight(0.0, 10.0);
+  graph_type g(n);
+  for (std::size_t i = 0; i < n * degree; ++i) {
+    boost::add_edge(vertex(rng), vertex(rng), weight(rng), g);
+  }
+  return g;
+}
+
+// Seconds for a search from vertex 0 with the visitor
+template<typename Visitor>
+double time_search(const graph_type& g, Visitor visitor)
+{
+  dijkstra_type dijkstra = blink::make_resumable_dijkstra(g);
+  const std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+  dijkstra.init_from_source(0, visitor);
+  dijkstra.expand(blink::default_interruptor(), visitor);
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t n = argc > 1 ? std::atoi(argv[1]) : 300000;
+  const std::size_t degree = argc > 2 ? std::atoi(argv[2]) : 4;
+  const std::string trace_file = argc > 3 ? argv[3] : "trace.bin";
+  const std::string log_file = argc > 4 ? argv[4] : "trace.log";
+
+  const graph_type g = make_random_graph(n, degree);
+
+  // initialize_vertex, examine_vertex, discover_vertex and finish_vertex
+  // per vertex and examine_edge and edge_(not_)relaxed per edge
+  std::vector<blink::trace_record> records(4 * n + 2 * n * degree);
+  blink::trace_buffer buffer(&records[0], &records[0] + records.size());
+
+  std::cout << "visitor\tseconds" << std::endl;
+  std::cout << "none\t" << time_search(g, boost::default_dijkstra_visitor())
+    << std::endl;
+
+  buffer.restart();
+  std::cout << "trace_visitor\t" << time_search(g,
+    blink::make_trace_visitor(buffer, get(boost::vertex_index, g)))
+    << std::endl;
+
+  std::ofstream log(log_file.c_str());
+  std::cout << "logging_visitor\t" << time_search(g,
+    blink::logging_visitor<std::ofstream>(log)) << std::endl;
+
+  std::ofstream os(trace_file.c_str(), std::ios::binary);
+  blink::write_trace(os, buffer);
+  std::cerr << buffer.size() << " events, " << buffer.dropped()
+    << " dropped" << std::endl;
+  return 0;
+}
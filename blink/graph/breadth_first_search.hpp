@@ -33,6 +33,24 @@ struct default_interruptor
   }
 };
 
+// Interrupts when either of two interruptors does, the second is only asked
+// if the first does not interrupt.
+template<typename First, typename Second>
+struct either_interruptor
+{
+  either_interruptor(First first, Second second)
+    : m_first(first), m_second(second)
+  {}
+
+  inline bool do_interrupt()
+  {
+    return m_first.do_interrupt() || m_second.do_interrupt();
+  }
+
+  First m_first;
+  Second m_second;
+};
+
 template<class IncidenceGraph, class Buffer, class BFSVisitor
   , class ColorMap, class Interruptor>
 void breadth_first_visit_no_init
@@ -0,0 +1,123 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The counting_queue wraps the queue of a dijkstra search and counts the
+// pushes, pops and updates and the size of the heap in a Counters policy
+// (see dijkstra_counters.hpp). Passed as max_priority_queue parameter, it
+// provides the engine level counters that a visitor cannot see. With
+// no_counters it is the wrapped queue.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_COUNTING_QUEUE_HPP
+#define BLINK_GRAPH_COUNTING_QUEUE_HPP
+
+#include <blink/graph/dijkstra_counters.hpp>
+#include <blink/graph/dijkstra_queue.hpp> // clear
+
+#include <boost/graph/graph_traits.hpp>
+
+#include <cstddef>
+
+namespace blink {
+
+template<typename Queue, typename Counters = dijkstra_counters>
+struct counting_queue
+{
+  typedef typename Queue::value_type vertex_descriptor;
+  typedef vertex_descriptor value_type;
+  typedef Queue queue_type;
+  typedef Counters counters_type;
+
+  explicit counting_queue(const Queue& queue) : m_queue(queue)
+  {}
+
+  const vertex_descriptor& top() const
+  {
+    return m_queue.top();
+  }
+
+  void pop()
+  {
+    m_counters.on_pop(m_queue.size());
+    m_queue.pop();
+  }
+
+  void push(const vertex_descriptor& v)
+  {
+    m_queue.push(v);
+    m_counters.on_push(m_queue.size());
+  }
+
+  void update(const vertex_descriptor& v)
+  {
+    m_counters.on_update();
+    m_queue.update(v);
+  }
+
+  bool empty() const
+  {
+    return m_queue.empty();
+  }
+
+  std::size_t size() const
+  {
+    return m_queue.size();
+  }
+
+  inline void clear()
+  {
+    blink::clear(m_queue);
+  }
+
+  Counters& counters()
+  {
+    return m_counters;
+  }
+
+  const Counters& counters() const
+  {
+    return m_counters;
+  }
+
+private:
+  Queue m_queue;
+  Counters m_counters;
+};
+
+// Wrap the default dijkstra queue
+template <typename Graph, typename DistanceMap, typename IndexMap,
+  typename Compare, typename Counters = dijkstra_counters>
+struct counting_queue_bgl
+{
+  typedef dijkstra_queue_bgl<Graph, DistanceMap, IndexMap, Compare> traits;
+  typedef counting_queue<typename traits::type, Counters> type;
+
+  static type make(const Graph& graph, DistanceMap distance, Compare compare,
+    IndexMap index)
+  {
+    return type(traits::make(graph, distance, compare, index));
+  }
+};
+
+template <typename Graph, typename DistanceMap, typename IndexMap,
+  typename Compare>
+typename counting_queue_bgl<Graph, DistanceMap, IndexMap, Compare>::type
+  make_counting_queue(const Graph& graph, DistanceMap distance,
+    Compare compare, IndexMap index)
+{
+  return counting_queue_bgl<Graph, DistanceMap, IndexMap, Compare>::make(
+    graph, distance, compare, index);
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_COUNTING_QUEUE_HPP
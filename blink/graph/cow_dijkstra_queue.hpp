@@ -0,0 +1,190 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// A 4-ary indirect heap like boost::d_ary_heap_indirect, that keeps the
+// position of each vertex in a cow_vector_property_map. A fork() copies
+// the heap array, which holds only the frontier, and shares the position
+// map copy-on-write, so that forking a search does not allocate O(V).
+// dijkstra_queue_bgl uses it for searches with cow_vector_property_map
+// distances.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_COW_DIJKSTRA_QUEUE_HPP
+#define BLINK_GRAPH_COW_DIJKSTRA_QUEUE_HPP
+
+#include <blink/graph/property_maps/cow_vector_property_map.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace blink {
+
+template<typename Vertex, typename DistanceMap, typename IndexMap,
+  typename Compare>
+class cow_dijkstra_queue
+{
+public:
+  typedef std::size_t size_type;
+  typedef Vertex value_type;
+  typedef typename boost::property_traits<DistanceMap>::value_type key_type;
+  typedef DistanceMap key_map;
+  typedef cow_vector_property_map<size_type, IndexMap> index_in_heap_map;
+
+  // index_in_heap must hold size_type(-1) for all vertices
+  cow_dijkstra_queue(DistanceMap distance, index_in_heap_map index_in_heap,
+    const Compare& compare = Compare())
+    : m_compare(compare), m_distance(distance), m_index_in_heap(index_in_heap)
+  {}
+
+  // A queue with the same vertices for a fork of the search, ordered by
+  // the forked distance map.
+  cow_dijkstra_queue fork(DistanceMap distance) const
+  {
+    cow_dijkstra_queue queue(distance, m_index_in_heap.fork(), m_compare);
+    queue.m_data = m_data;
+    return queue;
+  }
+
+  size_type size() const
+  {
+    return m_data.size();
+  }
+
+  bool empty() const
+  {
+    return m_data.empty();
+  }
+
+  const Vertex& top() const
+  {
+    BOOST_ASSERT(!empty());
+    return m_data[0];
+  }
+
+  void push(const Vertex& v)
+  {
+    m_data.push_back(v);
+    preserve_heap_property_up(m_data.size() - 1);
+  }
+
+  void pop()
+  {
+    BOOST_ASSERT(!empty());
+    put(m_index_in_heap, m_data[0], size_type(-1));
+    const Vertex last = m_data.back();
+    m_data.pop_back();
+    if (!m_data.empty()) {
+      m_data[0] = last;
+      preserve_heap_property_down();
+    }
+  }
+
+  // decrease-key, after the distance of v was reduced
+  void update(const Vertex& v)
+  {
+    preserve_heap_property_up(get(m_index_in_heap, v));
+  }
+
+  bool contains(const Vertex& v) const
+  {
+    return get(m_index_in_heap, v) != size_type(-1);
+  }
+
+  void push_or_update(const Vertex& v)
+  {
+    if (contains(v)) {
+      update(v);
+    } else {
+      push(v);
+    }
+  }
+
+  void clear()
+  {
+    for (std::size_t i = 0; i < m_data.size(); ++i) {
+      put(m_index_in_heap, m_data[i], size_type(-1));
+    }
+    m_data.clear();
+  }
+
+  DistanceMap keys() const
+  {
+    return m_distance;
+  }
+
+private:
+  static const size_type arity = 4;
+
+  bool before(const Vertex& a, const Vertex& b) const
+  {
+    return m_compare(get(m_distance, a), get(m_distance, b));
+  }
+
+  void place(size_type index, const Vertex& v)
+  {
+    m_data[index] = v;
+    put(m_index_in_heap, v, index);
+  }
+
+  void preserve_heap_property_up(size_type index)
+  {
+    const Vertex v = m_data[index];
+    while (index > 0) {
+      const size_type parent = (index - 1) / arity;
+      if (!before(v, m_data[parent])) {
+        break;
+      }
+      place(index, m_data[parent]);
+      index = parent;
+    }
+    place(index, v);
+  }
+
+  void preserve_heap_property_down()
+  {
+    const Vertex v = m_data[0];
+    const size_type n = m_data.size();
+    size_type index = 0;
+    for (;;) {
+      const size_type first = index * arity + 1;
+      if (first >= n) {
+        break;
+      }
+      const size_type last = std::min(first + arity, n);
+      size_type best = first;
+      for (size_type child = first + 1; child < last; ++child) {
+        if (before(m_data[child], m_data[best])) {
+          best = child;
+        }
+      }
+      if (!before(m_data[best], v)) {
+        break;
+      }
+      place(index, m_data[best]);
+      index = best;
+    }
+    place(index, v);
+  }
+
+  Compare m_compare;
+  std::vector<Vertex> m_data;
+  DistanceMap m_distance;
+  index_in_heap_map m_index_in_heap;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_COW_DIJKSTRA_QUEUE_HPP
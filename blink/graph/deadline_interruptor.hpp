@@ -0,0 +1,160 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// deadline_interruptor implements the interruptor concept. It returns true
+// on do_interrupt() once a time budget has passed since it was started.
+// The clock is only read every check_interval() calls. The interval
+// calibrates itself so that the clock is read about granularity times per
+// budget, which limits the overshoot to roughly budget / granularity.
+//
+// Copies share their state, so it can be passed by value to expand() and
+// queried afterwards.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DEADLINE_INTERRUPTOR_HPP
+#define BLINK_GRAPH_DEADLINE_INTERRUPTOR_HPP
+
+#include <boost/shared_ptr.hpp>
+
+#include <chrono>
+#include <cstddef>
+
+namespace blink {
+
+class deadline_interruptor
+{
+public:
+  typedef std::chrono::steady_clock clock_type;
+  typedef clock_type::duration duration;
+  typedef clock_type::time_point time_point;
+
+  // Starts the clock
+  explicit deadline_interruptor(duration budget, std::size_t granularity = 16)
+    : m_state(new state(budget, granularity))
+  {
+    restart();
+  }
+
+  // Start a new slice with the same budget, the check interval is kept.
+  void restart()
+  {
+    m_state->m_start = clock_type::now();
+    m_state->m_last_check = m_state->m_start;
+    m_state->m_used = duration::zero();
+    m_state->m_count = 0;
+    m_state->m_expired = false;
+  }
+
+  void restart(duration budget)
+  {
+    m_state->m_budget = budget;
+    restart();
+  }
+
+  inline bool do_interrupt()
+  {
+    state& s = *m_state;
+    if (s.m_expired) {
+      return true;
+    }
+    if (++s.m_count < s.m_interval) {
+      return false;
+    }
+    check();
+    return s.m_expired;
+  }
+
+  // The time used at the last clock read. After the search was interrupted
+  // this is the time until the interrupt.
+  duration used() const
+  {
+    return m_state->m_used;
+  }
+
+  // Read the clock now
+  duration elapsed() const
+  {
+    return clock_type::now() - m_state->m_start;
+  }
+
+  duration budget() const
+  {
+    return m_state->m_budget;
+  }
+
+  bool expired() const
+  {
+    return m_state->m_expired;
+  }
+
+  // The number of calls to do_interrupt() per clock read
+  std::size_t check_interval() const
+  {
+    return m_state->m_interval;
+  }
+
+private:
+  struct state
+  {
+    state(duration budget, std::size_t granularity)
+      : m_budget(budget), m_granularity(granularity > 0 ? granularity : 1)
+      , m_interval(1), m_count(0), m_expired(false)
+    {}
+
+    duration m_budget;
+    std::size_t m_granularity;
+    std::size_t m_interval;
+    std::size_t m_count;
+    bool m_expired;
+    time_point m_start;
+    time_point m_last_check;
+    duration m_used;
+  };
+
+  // Read the clock and scale the interval so that the next read is
+  // budget / granularity from now, or at the deadline if that is sooner.
+  // The interval at most doubles per read, to be robust against a coarse
+  // clock.
+  void check()
+  {
+    state& s = *m_state;
+    const time_point now = clock_type::now();
+    const duration since_last = now - s.m_last_check;
+    s.m_used = now - s.m_start;
+    s.m_last_check = now;
+    if (s.m_used >= s.m_budget) {
+      s.m_expired = true;
+      return;
+    }
+
+    duration target = s.m_budget / s.m_granularity;
+    const duration remaining = s.m_budget - s.m_used;
+    if (remaining < target) {
+      target = remaining;
+    }
+    std::size_t interval = 2 * s.m_count;
+    if (since_last > duration::zero()) {
+      const double scale = double(target.count()) / since_last.count();
+      if (scale * s.m_count < interval) {
+        interval = std::size_t(scale * s.m_count);
+      }
+    }
+    s.m_interval = interval > 0 ? interval : 1;
+    s.m_count = 0;
+  }
+
+  boost::shared_ptr<state> m_state;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_DEADLINE_INTERRUPTOR_HPP
@@ -0,0 +1,430 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// A parallel delta-stepping (Meyer and Sanders) shortest path search that
+// continues from the state left by the sequential algorithm: black vertices
+// are final, gray vertices are in the queue. On return all reachable
+// vertices are black and the queue is empty.
+//
+// Tentative distances are kept in an array of atomics. A relaxation that
+// lowers a distance sets it together with the predecessor under a per
+// vertex spin lock, so the predecessor is always the vertex whose
+// relaxation set the final distance. The distance, predecessor and color
+// maps are written once at the end. Distances equal those of the 
+// sequential algorithm, predecessors form a shortest path tree but may 
+// differ where paths tie. Visitors and interruptors are not applied. The
+// bucket width delta must be positive. Only non-empty buckets are stored, so
+// memory does not grow with the largest distance over delta.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DELTA_STEPPING_HPP
+#define BLINK_GRAPH_DELTA_STEPPING_HPP
+
+#include <blink/graph/dijkstra_queue.hpp> // clear
+
+#include <boost/graph/exception.hpp> // negative_edge
+#include <boost/graph/named_function_params.hpp> // max_priority_queue_t
+#include <boost/noncopyable.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp> // color_traits
+#include <boost/property_map/property_map.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/tuple/tuple.hpp> //tie
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept> // invalid_argument
+#include <thread>
+#include <vector>
+
+namespace blink {
+
+namespace detail {
+
+// Lower a to value and set parent if value compares less, returns true if
+// it did. The lock makes the pair change at once, reads of a need no lock.
+template<typename T, typename Compare>
+bool atomic_min_with_parent(std::atomic<T>& a, const T& value, 
+  const Compare& compare, std::atomic<bool>& lock, std::size_t& parent,
+  std::size_t p)
+{
+  if (!compare(value, a.load(std::memory_order_relaxed))) {
+    return false;
+  }
+  while (lock.exchange(true, std::memory_order_acquire)) {
+  }
+  const bool lower = compare(value, a.load(std::memory_order_relaxed));
+  if (lower) {
+    a.store(value, std::memory_order_relaxed);
+    parent = p;
+  }
+  lock.store(false, std::memory_order_release);
+  return lower;
+}
+
+// A reusable barrier for a fixed number of threads
+class phase_barrier : boost::noncopyable
+{
+public:
+  explicit phase_barrier(std::size_t count) 
+    : m_count(count), m_waiting(0), m_generation(0)
+  {}
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const std::size_t generation = m_generation;
+    if (++m_waiting == m_count) {
+      m_waiting = 0;
+      ++m_generation;
+      m_cv.notify_all();
+      return;
+    }
+    while (generation == m_generation) {
+      m_cv.wait(lock);
+    }
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  const std::size_t m_count;
+  std::size_t m_waiting;
+  std::size_t m_generation;
+};
+
+// num_threads - 1 worker threads that are kept for many phases. run(f, n)
+// splits [0, n) into num_threads contiguous blocks and calls f(thread, begin, end)
+// for each block, the calling thread takes the first block. A phase starts
+// and ends at a barrier. Rethrows the first exception that escaped from f.
+template<typename Function>
+class block_team : boost::noncopyable
+{
+public:
+  explicit block_team(std::size_t num_threads)
+    : m_barrier(num_threads == 0 ? 1 : num_threads), m_function(0), m_n(0)
+    , m_stop(false)
+  {
+    for (std::size_t t = 1; t < num_threads; ++t) {
+      m_threads.push_back(std::thread(&block_team::work, this, t));
+    }
+  }
+
+  ~block_team()
+  {
+    if (!m_threads.empty()) {
+      m_stop = true;
+      m_barrier.wait();
+    }
+    for (std::size_t t = 0; t < m_threads.size(); ++t) {
+      m_threads[t].join();
+    }
+  }
+
+  void run(const Function& f, std::size_t n)
+  {
+    if (m_threads.empty() || n < 2) {
+      f(std::size_t(0), std::size_t(0), n);
+      return;
+    }
+    m_function = &f;
+    m_n = n;
+    m_barrier.wait();
+    call_block(0);
+    m_barrier.wait();
+    if (m_exception) {
+      std::exception_ptr e = m_exception;
+      m_exception = std::exception_ptr();
+      std::rethrow_exception(e);
+    }
+  }
+
+private:
+  void work(std::size_t thread)
+  {
+    for (;;) {
+      m_barrier.wait();
+      if (m_stop) {
+        return;
+      }
+      call_block(thread);
+      m_barrier.wait();
+    }
+  }
+
+  void call_block(std::size_t thread)
+  {
+    const std::size_t num_threads = m_threads.size() + 1;
+    const std::size_t block = (m_n + num_threads - 1) / num_threads;
+    const std::size_t begin = thread * block < m_n ? thread * block : m_n;
+    const std::size_t end = begin + block < m_n ? begin + block : m_n;
+    if (begin == end) {
+      return;
+    }
+    try {
+      (*m_function)(thread, begin, end);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_exception) {
+        m_exception = std::current_exception();
+      }
+    }
+  }
+
+  phase_barrier m_barrier; // also orders m_function, m_n and m_stop
+  std::vector<std::thread> m_threads;
+  const Function* m_function;
+  std::size_t m_n;
+  bool m_stop;
+  std::mutex m_mutex; // guards m_exception
+  std::exception_ptr m_exception;
+};
+
+} // namespace detail
+
+template <class Graph, class PredecessorMap, class DistanceMap,
+  class WeightMap, class IndexMap, class Compare, class Combine,
+  class DistZero, class ColorMap, class MutableQueue>
+void delta_stepping_shortest_paths_no_init(const Graph& g,
+  PredecessorMap predecessor, DistanceMap distance, WeightMap weight,
+  IndexMap index, Compare compare, Combine combine, DistZero zero, ColorMap color, MutableQueue& queue,
+  std::size_t num_threads,
+  typename boost::property_traits<DistanceMap>::value_type delta)
+{
+  typedef boost::graph_traits<Graph> traits;
+  typedef typename traits::vertex_descriptor vertex_descriptor;
+  typedef typename traits::vertex_iterator vertex_iterator;
+  typedef typename traits::out_edge_iterator out_edge_iterator;
+  typedef typename boost::property_traits<DistanceMap>::value_type distance_type;
+  typedef typename boost::property_traits<ColorMap>::value_type color_type;
+  typedef boost::color_traits<color_type> color_traits;
+  typedef std::vector<vertex_descriptor> bucket_type;
+  typedef std::map<std::size_t, bucket_type> bucket_map;
+
+  const std::size_t n = num_vertices(g);
+  const std::size_t no_vertex = std::numeric_limits<std::size_t>::max();
+  if (num_threads == 0) {
+    num_threads = 1;
+  }
+  if (num_threads > n && n > 0) {
+    num_threads = n;
+  }
+  if (!compare(zero, delta)) {
+    boost::throw_exception(std::invalid_argument(
+      "delta_stepping: delta must be positive"));
+  }
+
+  // Copy the state of the sequential search.
+  std::vector<vertex_descriptor> vertex_of(n);
+  std::vector<std::atomic<distance_type> > dist(n);
+  std::vector<unsigned char> settled(n, 0);
+  vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    const std::size_t i = get(index, *vi);
+    vertex_of[i] = *vi;
+    dist[i].store(get(distance, *vi), std::memory_order_relaxed);
+    settled[i] = get(color, *vi) == color_traits::black() ? 1 : 0;
+  }
+  // The vertex (index) whose relaxation set the distance, or no_vertex if
+  // it was not lowered; guarded by lock.
+  std::vector<std::size_t> parent(n, no_vertex);
+  std::vector<std::atomic<bool> > lock(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    lock[i].store(false, std::memory_order_relaxed);
+  }
+  // The last round a vertex was scanned in, and the last bucket it was 
+  // settled in; used to skip duplicates.
+  std::vector<std::size_t> round_stamp(n, no_vertex);
+  std::vector<std::size_t> bucket_stamp(n, no_vertex);
+  std::size_t round = 0;
+
+  // Buckets are numbered by floor(distance / delta), the map holds the
+  // non-empty buckets from the current one onwards.
+  bucket_map buckets;
+  while (!queue.empty()) {
+    const vertex_descriptor u = queue.top();
+    queue.pop();
+    const std::size_t b = static_cast<std::size_t>(
+      dist[get(index, u)].load(std::memory_order_relaxed) / delta);
+    buckets[b].push_back(u);
+  }
+
+  std::vector<bucket_type> inserted(num_threads);
+  std::atomic<bool> negative(false);
+  bucket_type frontier;
+  bucket_type settled_in_bucket;
+
+  // Relax the out-edges of frontier[begin, end) that are light (or heavy),
+  // collecting targets that improved per thread.
+  struct relax_block
+  {
+    const Graph& g;
+    WeightMap weight;
+    IndexMap index;
+    Compare compare;
+    Combine combine;
+    DistZero zero;
+    distance_type delta;
+    bool light;
+    const bucket_type& frontier;
+    std::vector<std::atomic<distance_type> >& dist;
+    std::vector<std::atomic<bool> >& lock;
+    std::vector<std::size_t>& parent;
+    std::vector<bucket_type>& inserted;
+    std::atomic<bool>& negative;
+
+    void operator()(std::size_t thread, std::size_t begin, std::size_t end) const
+    {
+      bucket_type& out = inserted[thread];
+      out_edge_iterator ei, ei_end;
+      for (std::size_t i = begin; i < end; ++i) {
+        const vertex_descriptor u = frontier[i];
+        const std::size_t i_u = get(index, u);
+        const distance_type d_u = dist[i_u].load(std::memory_order_relaxed);
+        for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+          const distance_type w = get(weight, *ei);
+          if (compare(w, zero)) {
+            negative.store(true, std::memory_order_relaxed);
+            continue;
+          }
+          if (compare(w, delta) != light) {
+            continue;
+          }
+          const vertex_descriptor v = target(*ei, g);
+          const std::size_t j = get(index, v);
+          if (detail::atomic_min_with_parent(dist[j], combine(d_u, w), 
+            compare, lock[j], parent[j], i_u)) {
+            out.push_back(v);
+          }
+        }
+      }
+    }
+  };
+
+  // The same threads relax all light rounds and heavy phases
+  detail::block_team<relax_block> team(num_threads);
+
+  while (!buckets.empty()) {
+    // Inserting into the map does not invalidate current
+    const typename bucket_map::iterator current = buckets.begin();
+    if (current->second.empty()) {
+      buckets.erase(current);
+      continue;
+    }
+    const std::size_t base = current->first;
+    settled_in_bucket.clear();
+
+    // Light edges, repeated until no vertex falls in the current bucket
+    while (!current->second.empty()) {
+      frontier.clear();
+      frontier.swap(current->second);
+
+      // Remove stale and duplicate entries
+      ++round;
+      std::size_t k = 0;
+      for (std::size_t i = 0; i < frontier.size(); ++i) {
+        const vertex_descriptor v = frontier[i];
+        const std::size_t j = get(index, v);
+        const distance_type d_v = dist[j].load(std::memory_order_relaxed);
+        if (settled[j] || round_stamp[j] == round
+          || static_cast<std::size_t>(d_v / delta) != base) {
+          continue;
+        }
+        round_stamp[j] = round;
+        if (bucket_stamp[j] != base) {
+          bucket_stamp[j] = base;
+          settled_in_bucket.push_back(v);
+        }
+        frontier[k++] = v;
+      }
+      frontier.resize(k);
+
+      relax_block light = { g, weight, index, compare, combine, zero, delta,
+        true, frontier, dist, lock, parent, inserted, negative };
+      team.run(light, frontier.size());
+
+      for (std::size_t t = 0; t < num_threads; ++t) {
+        for (std::size_t i = 0; i < inserted[t].size(); ++i) {
+          const vertex_descriptor v = inserted[t][i];
+          const std::size_t b = static_cast<std::size_t>(
+            dist[get(index, v)].load(std::memory_order_relaxed) / delta);
+          buckets[b].push_back(v);
+        }
+        inserted[t].clear();
+      }
+    }
+
+    // Heavy edges, once for all vertices settled in this bucket
+    relax_block heavy = { g, weight, index, compare, combine, zero, delta,
+      false, settled_in_bucket, dist, lock, parent, inserted, negative };
+    team.run(heavy, settled_in_bucket.size());
+    for (std::size_t i = 0; i < settled_in_bucket.size(); ++i) {
+      settled[get(index, settled_in_bucket[i])] = 1;
+    }
+    for (std::size_t t = 0; t < num_threads; ++t) {
+      for (std::size_t i = 0; i < inserted[t].size(); ++i) {
+        const vertex_descriptor v = inserted[t][i];
+        const std::size_t b = static_cast<std::size_t>(
+          dist[get(index, v)].load(std::memory_order_relaxed) / delta);
+        buckets[b].push_back(v);
+      }
+      inserted[t].clear();
+    }
+  }
+  if (negative.load()) {
+    boost::throw_exception(boost::negative_edge());
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const vertex_descriptor v = vertex_of[i];
+    if (!settled[i]) {
+      continue;
+    }
+    put(color, v, color_traits::black());
+    if (parent[i] != no_vertex) {
+      put(distance, v, dist[i].load(std::memory_order_relaxed));
+      put(predecessor, v, vertex_of[parent[i]]);
+    }
+  }
+  clear(queue);
+}
+
+// Expand a resumable_dijkstra exhaustively with delta-stepping on
+// num_threads threads with bucket width delta. Distances are the same as
+// for expand(), visitors are not applied. Returns whether the queue is
+// empty, as expand() does.
+template<typename Dijkstra>
+bool expand_parallel(Dijkstra& dijkstra, std::size_t num_threads,
+  typename Dijkstra::template param<boost::distance_inf_t>::type delta)
+{
+  delta_stepping_shortest_paths_no_init(dijkstra.get_graph(),
+    dijkstra.get(boost::vertex_predecessor_t()),
+    dijkstra.get(boost::vertex_distance_t()),
+    dijkstra.get(boost::edge_weight_t()),
+    dijkstra.get(boost::vertex_index_t()),
+    dijkstra.get(boost::distance_compare_t()),
+    dijkstra.get(boost::distance_combine_t()),
+    dijkstra.get(boost::distance_zero_t()),
+    dijkstra.get(boost::vertex_color_t()),
+    dijkstra.get(boost::max_priority_queue_t()), num_threads, delta);
+
+  return dijkstra.get(boost::max_priority_queue_t()).empty();
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_DELTA_STEPPING_HPP
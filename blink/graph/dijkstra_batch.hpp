@@ -0,0 +1,193 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Runs many independent single source searches on a thread_pool. The
+// searches are taken from a dijkstra_state_pool, so the property maps and
+// queue are allocated once per concurrent job instead of once per job, and
+// only the vertices discovered by a job are reset after it. The graph is 
+// shared read-only.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_BATCH_HPP
+#define BLINK_GRAPH_DIJKSTRA_BATCH_HPP
+
+#include <blink/graph/dijkstra_state_pool.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+#include <blink/graph/thread_pool.hpp>
+#include <blink/graph/dijkstra_visitor/distance_visitor.hpp>
+
+#include <boost/graph/named_function_params.hpp>
+#include <boost/graph/properties.hpp> // color_traits
+#include <boost/property_map/property_map.hpp>
+#include <boost/range.hpp>
+
+#include <cstddef>
+
+namespace blink {
+
+// The Params are used to make the pooled searches. They must not hold
+// vertex property maps (distance, color, predecessor), a queue or a graph 
+// visitor, see dijkstra_state_pool.
+template<typename Graph, typename Params = boost::no_named_parameters>
+class dijkstra_batch
+{
+public:
+  typedef dijkstra_state_pool<Graph, Params> state_pool_type;
+  typedef typename state_pool_type::dijkstra_type dijkstra_type;
+
+  dijkstra_batch(const Graph& graph, thread_pool& pool,
+    const Params& params = Params())
+    : m_pool(pool), m_states(graph, pool.size(), params)
+  {}
+
+  // Calls run_job(dijkstra, job, i) for the i-th job of the random access
+  // range, on the thread pool. The jobs are posted in chunks of chunk_size,
+  // idle workers steal chunks from busy ones. The resumable_dijkstra is 
+  // handed to run_job with all vertices white and an empty queue. Returns 
+  // when all jobs are done.
+  template<typename JobRange, typename RunJob>
+  void run(const JobRange& jobs, RunJob run_job, std::size_t chunk_size = 16)
+  {
+    if (chunk_size == 0) {
+      chunk_size = 1;
+    }
+    const std::size_t n = boost::size(jobs);
+    for (std::size_t begin = 0; begin < n; begin += chunk_size) {
+      const std::size_t end = begin + chunk_size < n ? begin + chunk_size : n;
+      m_pool.post(chunk<JobRange, RunJob>(*this, jobs, run_job, begin, end));
+    }
+    m_pool.wait();
+  }
+
+private:
+  template<typename JobRange, typename RunJob>
+  struct chunk
+  {
+    chunk(dijkstra_batch& batch, const JobRange& jobs, RunJob run_job,
+      std::size_t begin, std::size_t end)
+      : m_batch(&batch), m_jobs(&jobs), m_run_job(run_job), m_begin(begin)
+      , m_end(end)
+    {}
+
+    void operator()()
+    {
+      typename boost::range_iterator<const JobRange>::type i
+        = boost::begin(*m_jobs) + m_begin;
+      for (std::size_t k = m_begin; k != m_end; ++k, ++i) {
+        typename state_pool_type::handle dijkstra = m_batch->m_states.acquire();
+        m_run_job(*dijkstra, *i, k);
+      }
+    }
+
+    dijkstra_batch* m_batch;
+    const JobRange* m_jobs;
+    RunJob m_run_job;
+    std::size_t m_begin;
+    std::size_t m_end;
+  };
+
+  thread_pool& m_pool;
+  state_pool_type m_states;
+};
+
+// Writes, for each job, the distances to a fixed set of column vertices
+// into a row-major matrix: out[job * num_columns + column]. Columns that
+// the job did not settle (not black) get the infinite distance.
+template<typename VertexRange, typename OutputIterator>
+struct distance_matrix_writer
+{
+  distance_matrix_writer(const VertexRange& columns, OutputIterator out)
+    : m_columns(&columns), m_out(out), m_num_columns(boost::size(columns))
+  {}
+
+  template<typename Dijkstra>
+  void operator()(std::size_t job, Dijkstra& dijkstra) const
+  {
+    typedef typename Dijkstra::template param<boost::vertex_color_t>::type 
+      color_map_type;
+    typedef typename boost::property_traits<color_map_type>::value_type 
+      color_type;
+    typedef boost::color_traits<color_type> color_traits;
+
+    const color_map_type& color = dijkstra.get(boost::vertex_color_t());
+    typename boost::range_iterator<const VertexRange>::type
+      i = boost::begin(*m_columns), end = boost::end(*m_columns);
+    OutputIterator out = m_out + job * m_num_columns;
+    for (; i != end; ++i, ++out) {
+      if (get(color, *i) == color_traits::black()) {
+        *out = get(dijkstra.get(boost::vertex_distance_t()), *i);
+      } else {
+        *out = dijkstra.get(boost::distance_inf_t());
+      }
+    }
+  }
+
+  const VertexRange* m_columns;
+  OutputIterator m_out;
+  std::size_t m_num_columns;
+};
+
+template<typename VertexRange, typename OutputIterator>
+distance_matrix_writer<VertexRange, OutputIterator>
+  make_distance_matrix_writer(const VertexRange& columns, OutputIterator out)
+{
+  return distance_matrix_writer<VertexRange, OutputIterator>(columns, out);
+}
+
+namespace detail {
+
+template<typename Callback>
+struct distance_batch_job
+{
+  distance_batch_job(Callback callback) : m_callback(callback)
+  {}
+
+  // Job is a pair of source vertex and target distance
+  template<typename DijkstraState, typename Job>
+  void operator()(resumable_dijkstra<DijkstraState>& dijkstra, const Job& job,
+    std::size_t i)
+  {
+    typedef typename distance_visitor_helper<DijkstraState>::type visitor_type;
+    visitor_type visitor = make_distance_visitor(dijkstra.get_dijkstra_state(),
+      job.second);
+    dijkstra.put_source(job.first, visitor);
+    dijkstra.expand(visitor, visitor);
+    m_callback(i, dijkstra);
+  }
+
+  Callback m_callback;
+};
+
+} // namespace detail
+
+// The batch version of dijkstra_shortest_path_distance. Jobs is a random
+// access range of (source, target distance) pairs. Callback is called as
+// callback(i, dijkstra) on a worker thread after the i-th job is expanded.
+template<typename Graph, typename JobRange, typename Callback, typename Params>
+void dijkstra_shortest_path_distance_batch(const Graph& g, const JobRange& jobs,
+  Callback callback, thread_pool& pool, const Params& params)
+{
+  dijkstra_batch<Graph, Params> batch(g, pool, params);
+  batch.run(jobs, detail::distance_batch_job<Callback>(callback));
+}
+
+template<typename Graph, typename JobRange, typename Callback>
+void dijkstra_shortest_path_distance_batch(const Graph& g, const JobRange& jobs,
+  Callback callback, thread_pool& pool)
+{
+  dijkstra_shortest_path_distance_batch(g, jobs, callback, pool,
+    boost::no_named_parameters());
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_DIJKSTRA_BATCH_HPP
@@ -9,7 +9,10 @@
 //=======================================================================
 //
 // dijkstra_control is used to tell the algorithm object implementations 
-// of dijkstra shortest path at which control_points to halt
+// of dijkstra shortest path at which control_points to halt. The
+// predefined control maps are control_point_sets, compile time bitmasks
+// that are cheaper to instantiate than the boost::mpl vectors that are
+// also accepted.
 //
 //=======================================================================
 //
@@ -41,6 +44,90 @@ enum control_point
   cp_invalid
 };
 
+// The record of a control point, as yielded by dijkstra_generator and 
+// written by dijkstra_object::fill
+template<typename Vertex, typename Edge>
+struct dijkstra_event
+{
+  control_point cp;
+  Vertex u; // latest (source) vertex
+  Vertex v; // latest (target) vertex
+  Edge e;   // latest edge, not set for the vertex control points
+
+  // The vertex the control point is about, as dijkstra_object::get_vertex
+  Vertex vertex() const
+  {
+    switch (cp) {
+    case cp_gray_target:
+    case cp_black_target:
+    case cp_discover_vertex:
+      return v;
+    default:
+      return u;
+    }
+  }
+};
+
+// A set of control points as a compile time bitmask, to be used as
+// ControlMap. Sets are combined with the constexpr operators |, & and ~.
+template<unsigned Mask>
+struct control_point_set
+{
+  static const unsigned mask = Mask;
+
+  static constexpr bool contains(control_point cp)
+  {
+    return ((Mask >> cp) & 1u) != 0;
+  }
+};
+
+typedef control_point_set<(1u << cp_invalid) - 1> all_control_points_type;
+
+template<unsigned A, unsigned B>
+constexpr control_point_set<A | B> operator|(control_point_set<A>,
+  control_point_set<B>)
+{
+  return control_point_set<A | B>();
+}
+
+template<unsigned A, unsigned B>
+constexpr control_point_set<A & B> operator&(control_point_set<A>,
+  control_point_set<B>)
+{
+  return control_point_set<A & B>();
+}
+
+template<unsigned A>
+constexpr control_point_set<~A & all_control_points_type::mask> operator~(
+  control_point_set<A>)
+{
+  return control_point_set<~A & all_control_points_type::mask>();
+}
+
+namespace detail {
+
+constexpr unsigned control_point_mask()
+{
+  return 0u;
+}
+
+template<typename... ControlPoints>
+constexpr unsigned control_point_mask(control_point cp,
+  ControlPoints... cps)
+{
+  return (cp == cp_invalid ? 0u : 1u << cp) | control_point_mask(cps...);
+}
+
+} // namespace detail
+
+template<control_point... CPs>
+struct make_control_point_set
+{
+  typedef control_point_set<detail::control_point_mask(CPs...)> type;
+};
+
+// ControlMap is a control_point_set, or a boost::mpl vector of true_type and
+// false_type indexed by control_point
 template<typename ControlMap, control_point CP>
 struct is_cp_included
 {
@@ -48,43 +135,28 @@ struct is_cp_included
   static const bool value = type::value;
 };
 
+template<unsigned Mask, control_point CP>
+struct is_cp_included<control_point_set<Mask>, CP>
+{
+  typedef boost::integral_constant<bool,
+    control_point_set<Mask>::contains(CP)> type;
+  static const bool value = type::value;
+};
+
 template<control_point CP>
 struct one_control_point_vector
 {
-  template<control_point CP2>
-  struct is_same_cp
-  {
-    typedef typename boost::is_same<
-      boost::integral_constant<control_point, CP>, 
-      boost::integral_constant<control_point, CP2> >::type type;
-  };
-  typedef typename boost::mpl::vector
-    < typename is_same_cp<cp_initialize_vertex>::type
-    , typename is_same_cp<cp_examine_vertex>::type
-    , typename is_same_cp<cp_examine_edge>::type
-    , typename is_same_cp<cp_tree_edge>::type
-    , typename is_same_cp<cp_discover_vertex>::type
-    , typename is_same_cp<cp_non_tree_edge>::type
-    , typename is_same_cp<cp_gray_target>::type
-    , typename is_same_cp<cp_black_target>::type
-    , typename is_same_cp<cp_finish_vertex>::type
-    , typename is_same_cp<cp_edge_relaxed>::type
-    , typename is_same_cp<cp_edge_not_relaxed>::type
-    >::type type;
+  typedef typename make_control_point_set<CP>::type type;
 };
-  
-typedef boost::mpl::vector
-  < boost::true_type //initialize_vertex
-  , boost::true_type //examine_vertex
-  , boost::true_type //examine_vertex
-  , boost::false_type
-  , boost::true_type //discover_vertex
-  , boost::false_type
-  , boost::false_type
-  , boost::false_type
-  , boost::true_type //finish_vertex
-  , boost::true_type//edge_relaxed
-  , boost::true_type//edge_not_relaxed
+
+typedef make_control_point_set
+  < cp_initialize_vertex
+  , cp_examine_vertex
+  , cp_examine_edge
+  , cp_discover_vertex
+  , cp_finish_vertex
+  , cp_edge_relaxed
+  , cp_edge_not_relaxed
   >::type dijkstra_visitor_control_point_vector;
  
 typedef one_control_point_vector<cp_finish_vertex>::type only_finish_vertex_type;
@@ -102,23 +174,29 @@ struct elementwise_or
       typedef typename boost::mpl::if_
         <typename  boost::mpl::or_<one, two>::type
         , boost::true_type
-        , boost::false_type>::type or;
+        , boost::false_type>::type or_type;
     };
 
     typedef typename boost::mpl::vector
-    < typename is_included<cp_initialize_vertex>::or
-    , typename is_included<cp_examine_vertex>::or
-    , typename is_included<cp_examine_edge>::or
-    , typename is_included<cp_tree_edge>::or
-    , typename is_included<cp_discover_vertex>::or
-    , typename is_included<cp_non_tree_edge>::or
-    , typename is_included<cp_gray_target>::or
-    , typename is_included<cp_black_target>::or
-    , typename is_included<cp_finish_vertex>::or
-    , typename is_included<cp_edge_relaxed>::or
-    , typename is_included<cp_edge_not_relaxed>::or
+    < typename is_included<cp_initialize_vertex>::or_type
+    , typename is_included<cp_examine_vertex>::or_type
+    , typename is_included<cp_examine_edge>::or_type
+    , typename is_included<cp_tree_edge>::or_type
+    , typename is_included<cp_discover_vertex>::or_type
+    , typename is_included<cp_non_tree_edge>::or_type
+    , typename is_included<cp_gray_target>::or_type
+    , typename is_included<cp_black_target>::or_type
+    , typename is_included<cp_finish_vertex>::or_type
+    , typename is_included<cp_edge_relaxed>::or_type
+    , typename is_included<cp_edge_not_relaxed>::or_type
     >::type type;
 };
+
+template<unsigned Mask1, unsigned Mask2>
+struct elementwise_or<control_point_set<Mask1>, control_point_set<Mask2> >
+{
+  typedef control_point_set<Mask1 | Mask2> type;
+};
 } //namespace 
 
 #endif //BLINK_GRAPH_DIJKSTRA_CONTROL_HPP
\ No newline at end of file
@@ -0,0 +1,174 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Counter policies for counting_visitor and counting_queue. dijkstra_counters
+// counts in plain integers, so each search (and thread) needs its own, and
+// no_counters compiles to nothing. Counters of several searches or threads
+// are summed with += or with a dijkstra_counters_aggregator, and the work
+// of one expand() is the difference of the counters before and after.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_COUNTERS_HPP
+#define BLINK_GRAPH_DIJKSTRA_COUNTERS_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <mutex>
+
+namespace blink {
+
+struct no_counters
+{
+  void on_examine_vertex() {}
+  void on_discover_vertex() {}
+  void on_finish_vertex() {}
+  void on_examine_edge() {}
+  void on_edge_relaxed() {}
+  void on_edge_not_relaxed() {}
+  void on_push(std::size_t) {}
+  void on_pop(std::size_t) {}
+  void on_update() {}
+};
+
+struct dijkstra_counters
+{
+  dijkstra_counters()
+    : vertices_examined(0), vertices_discovered(0), vertices_finished(0)
+    , edges_examined(0), edges_relaxed(0), edges_not_relaxed(0)
+    , heap_pushes(0), heap_pops(0), heap_updates(0), heap_size_sum(0)
+    , max_heap_size(0)
+  {}
+
+  void on_examine_vertex() { ++vertices_examined; }
+  void on_discover_vertex() { ++vertices_discovered; }
+  void on_finish_vertex() { ++vertices_finished; }
+  void on_examine_edge() { ++edges_examined; }
+  void on_edge_relaxed() { ++edges_relaxed; }
+  void on_edge_not_relaxed() { ++edges_not_relaxed; }
+
+  // size after the push
+  void on_push(std::size_t size)
+  {
+    ++heap_pushes;
+    if (size > max_heap_size) {
+      max_heap_size = size;
+    }
+  }
+
+  // size before the pop
+  void on_pop(std::size_t size)
+  {
+    ++heap_pops;
+    heap_size_sum += size;
+  }
+
+  void on_update() { ++heap_updates; }
+
+  // The mean size of the heap when a vertex is popped
+  double mean_heap_size() const
+  {
+    return heap_pops == 0 ? 0.0
+      : static_cast<double>(heap_size_sum) / heap_pops;
+  }
+
+  // max_heap_size is the maximum of both
+  dijkstra_counters& operator+=(const dijkstra_counters& other)
+  {
+    vertices_examined += other.vertices_examined;
+    vertices_discovered += other.vertices_discovered;
+    vertices_finished += other.vertices_finished;
+    edges_examined += other.edges_examined;
+    edges_relaxed += other.edges_relaxed;
+    edges_not_relaxed += other.edges_not_relaxed;
+    heap_pushes += other.heap_pushes;
+    heap_pops += other.heap_pops;
+    heap_updates += other.heap_updates;
+    heap_size_sum += other.heap_size_sum;
+    if (other.max_heap_size > max_heap_size) {
+      max_heap_size = other.max_heap_size;
+    }
+    return *this;
+  }
+
+  // The counts since earlier, max_heap_size is that of *this
+  dijkstra_counters& operator-=(const dijkstra_counters& earlier)
+  {
+    vertices_examined -= earlier.vertices_examined;
+    vertices_discovered -= earlier.vertices_discovered;
+    vertices_finished -= earlier.vertices_finished;
+    edges_examined -= earlier.edges_examined;
+    edges_relaxed -= earlier.edges_relaxed;
+    edges_not_relaxed -= earlier.edges_not_relaxed;
+    heap_pushes -= earlier.heap_pushes;
+    heap_pops -= earlier.heap_pops;
+    heap_updates -= earlier.heap_updates;
+    heap_size_sum -= earlier.heap_size_sum;
+    return *this;
+  }
+
+  std::size_t vertices_examined;
+  std::size_t vertices_discovered;
+  std::size_t vertices_finished;
+  std::size_t edges_examined;
+  std::size_t edges_relaxed;
+  std::size_t edges_not_relaxed;
+  std::size_t heap_pushes;
+  std::size_t heap_pops;
+  std::size_t heap_updates;
+  std::size_t heap_size_sum;
+  std::size_t max_heap_size;
+};
+
+inline dijkstra_counters operator+(dijkstra_counters a,
+  const dijkstra_counters& b)
+{
+  return a += b;
+}
+
+inline dijkstra_counters operator-(dijkstra_counters a,
+  const dijkstra_counters& b)
+{
+  return a -= b;
+}
+
+// Sums the counters of searches on several threads. add() takes a lock,
+// so it is meant to be called once per expand(), not on the hot path.
+class dijkstra_counters_aggregator : boost::noncopyable
+{
+public:
+  void add(const dijkstra_counters& counters)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_total += counters;
+  }
+
+  dijkstra_counters total() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_total;
+  }
+
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_total = dijkstra_counters();
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  dijkstra_counters m_total;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_DIJKSTRA_COUNTERS_HPP
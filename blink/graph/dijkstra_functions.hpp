@@ -20,6 +20,7 @@
 #define BLINK_GRAPH_DIJKSTRA_FUNCTIONS_HPP
 
 #include <blink/graph/resumable_dijkstra.hpp>
+#include <blink/graph/delta_stepping.hpp> // expand_parallel
 #include <blink/graph/dijkstra_visitor/distance_visitor.hpp>
 #include <blink/graph/dijkstra_visitor/target_visitor.hpp>
 #include <blink/graph/dijkstra_visitor/nearest_source_visitor.hpp>
@@ -145,6 +146,36 @@ dijkstra_shortest_path_plain(const Graph& g,
 {
   return dijkstra_shortest_path_plain(g, source, boost::no_named_parameters());
 }
+
+//dijkstra_shortest_path_plain_parallel
+template<typename Graph, typename Params>
+typename dijkstra_state_helper<Graph, Params>::type
+dijkstra_shortest_path_plain_parallel(const Graph& g, 
+  typename boost::graph_traits<Graph>::vertex_descriptor source, 
+  std::size_t num_threads,
+  typename dijkstra_state_helper<Graph, Params>::template 
+    param<boost::distance_inf_t>::type delta, 
+  const Params& params)
+{
+  typedef typename dijkstra_state_helper<Graph, Params>::type state_type;
+  state_type state = dijkstra_state_helper<Graph, Params>::make(g, params);
+  resumable_dijkstra<state_type> dijkstra(state);
+  dijkstra.init_from_source(source);
+  expand_parallel(dijkstra, num_threads, delta);
+  return state;
+}
+
+template<typename Graph>
+typename dijkstra_state_helper<Graph, boost::no_named_parameters>::type
+dijkstra_shortest_path_plain_parallel(const Graph& g, 
+  typename boost::graph_traits<Graph>::vertex_descriptor source,
+  std::size_t num_threads,
+  typename dijkstra_state_helper<Graph, boost::no_named_parameters>::template 
+    param<boost::distance_inf_t>::type delta)
+{
+  return dijkstra_shortest_path_plain_parallel(g, source, num_threads, delta, 
+    boost::no_named_parameters());
+}
    
 } // namespace boost
 
@@ -32,7 +32,7 @@ struct dijkstra_heap_wrapper
 	typedef typename boost::graph_traits<Graph>::traversal_category traversal_category;
   typedef typename MutableQueue::handle_type handle_type;
 	typedef typename MutableQueue::value_compare compare_type;
-  typedef typename vertex_property_map_helper<handle_type,Graph, VertexIndexMap> helper;
+  typedef vertex_property_map_helper<handle_type,Graph, VertexIndexMap> helper;
   typedef typename helper::type handle_map_type;
 
   BOOST_STATIC_ASSERT((boost::is_same<vertex_descriptor
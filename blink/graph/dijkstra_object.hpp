@@ -34,6 +34,8 @@
 #include <boost/property_map/property_map.hpp>
 #include <boost/range.hpp>
 
+#include <cstddef>
+
 #include <boost/asio/yield.hpp> // defines macros, undefined at bottom of this file
 
 namespace blink {
@@ -41,9 +43,48 @@ namespace blink {
 template<typename DijkstraState, typename SourceRange, typename ControlMap>
 struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
 {
+protected:
+  typedef dijkstra_state_mixin<DijkstraState> mixin;
+  typedef typename mixin::graph_type graph_type;
+  typedef typename mixin::distance_combine_type distance_combine_type;
+  typedef typename mixin::distance_compare_type distance_compare_type;
+  typedef typename mixin::distance_inf_type distance_inf_type;
+  typedef typename mixin::distance_zero_type distance_zero_type;
+  typedef typename mixin::edge_weight_type edge_weight_type;
+  typedef typename mixin::max_priority_queue_type max_priority_queue_type;
+  typedef typename mixin::vertex_color_type vertex_color_type;
+  typedef typename mixin::vertex_distance_type vertex_distance_type;
+  typedef typename mixin::vertex_index_type vertex_index_type;
+  typedef typename mixin::vertex_predecessor_type vertex_predecessor_type;
+  typedef typename mixin::graph_visitor_type graph_visitor_type;
+  typedef typename mixin::graph_traits graph_traits;
+  typedef typename mixin::vertex_descriptor vertex_descriptor;
+  typedef typename mixin::vertex_iterator vertex_iterator;
+  typedef typename mixin::edge_descriptor edge_descriptor;
+  typedef typename mixin::out_edge_iterator out_edge_iterator;
+  typedef typename mixin::distance_type distance_type;
+  typedef typename mixin::color_type color_type;
+  typedef typename mixin::color_traits color_traits;
+
+  using mixin::m_graph;
+  using mixin::m_distance_combine;
+  using mixin::m_distance_compare;
+  using mixin::m_distance_inf;
+  using mixin::m_distance_zero;
+  using mixin::m_edge_weight;
+  using mixin::m_graph_visitor;
+  using mixin::m_max_priority_queue;
+  using mixin::m_vertex_color;
+  using mixin::m_vertex_distance;
+  using mixin::m_vertex_index;
+  using mixin::m_vertex_predecessor;
+
+public:
+  typedef dijkstra_event<vertex_descriptor, edge_descriptor> event_type;
+
   dijkstra_object(const DijkstraState& state, const SourceRange& source_range)
-    : dijkstra_state_mixin(boost::shared_ptr<DijkstraState>(new DijkstraState(state) ) )
-    , m_source_range(source_range) 
+    : mixin(boost::shared_ptr<DijkstraState>(new DijkstraState(state) ) )
+    , m_source_range(source_range), m_buffer(0), m_buffer_end(0)
   {}
     
   bool operator()() // jump to next control point
@@ -52,6 +93,26 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
     return !m_coro.is_complete();
   }
 
+  // Run over as many control points as fit in [first, last), writing an
+  // event for each. Returns the number of events written, the search has 
+  // ended if that is less than last - first.
+  // This is a convenience, not a speed up: the coroutine is only re-entered
+  // once per buffer, but writing the events costs as much as the yields it
+  // saves, and fill() measured no faster than operator().
+  std::size_t fill(event_type* first, event_type* last)
+  {
+    if (first == last) {
+      return 0;
+    }
+    m_buffer = first;
+    m_buffer_end = last;
+    func();
+    const std::size_t n = m_buffer - first;
+    m_buffer = 0;
+    m_buffer_end = 0;
+    return n;
+  }
+
   vertex_descriptor get_u() { return m_u; }          // latest (source) vertex
   vertex_descriptor get_v() { return m_v;}           // latest (target) vertex
   edge_descriptor get_e() { return m_e;}             // latest edge
@@ -89,9 +150,26 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
   }            
 
  private:
-  typedef typename typename boost::range_iterator<const SourceRange>::type source_range_iterator;
+  typedef typename boost::range_iterator<const SourceRange>::type source_range_iterator;
 
+  // A constant, so control points that are not in the ControlMap compile to 
+  // nothing. (if constexpr cannot be used, the yields are case labels.)
   template<control_point CP> struct yield_here : is_cp_included<ControlMap, CP> {};
+
+  // Returns whether to yield at control point cp, in buffer mode only when 
+  // the buffer is full
+  bool emit(control_point cp)
+  {
+    m_cp = cp;
+    if (m_buffer == 0) {
+      return true;
+    }
+    m_buffer->cp = cp;
+    m_buffer->u = m_u;
+    m_buffer->v = m_v;
+    m_buffer->e = m_e;
+    return ++m_buffer == m_buffer_end;
+  }
     
   // TODO (?): maybe it is useful return the control_point?
   void func()
@@ -103,7 +181,7 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
           m_v = *ui;
         
           m_graph_visitor.initialize_vertex(m_u, m_graph);
-          if(yield_here<cp_initialize_vertex>::value) yield m_cp = cp_initialize_vertex;
+          if(yield_here<cp_initialize_vertex>::value && emit(cp_initialize_vertex)) yield;
         
           put(m_vertex_color, m_u, color_traits::white() );
           put(m_vertex_predecessor, m_u, m_u);
@@ -122,7 +200,7 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
           m_v = *ri;
 
           m_graph_visitor.discover_vertex(*ri, m_graph);
-          if(yield_here<cp_discover_vertex>::value) yield m_cp = cp_discover_vertex;
+          if(yield_here<cp_discover_vertex>::value && emit(cp_discover_vertex)) yield;
         }
 
         // Main loop
@@ -131,7 +209,7 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
           m_max_priority_queue.pop();
 
           m_graph_visitor.examine_vertex(m_u, m_graph);
-          if(yield_here<cp_examine_vertex>::value) yield m_cp = cp_examine_vertex;
+          if(yield_here<cp_examine_vertex>::value && emit(cp_examine_vertex)) yield;
                 
           for (boost::tie(ei, ei_end) = out_edges(m_u, m_graph); ei != ei_end; ++ei) {
             m_e = *ei;
@@ -142,51 +220,51 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
             }
           
             m_graph_visitor.examine_edge(m_e, m_graph);
-            if(yield_here<cp_examine_edge>::value) yield m_cp = cp_examine_edge;
+            if(yield_here<cp_examine_edge>::value && emit(cp_examine_edge)) yield;
              
             v_color = boost::get(m_vertex_color, m_v);
             if (v_color == color_traits::white()) {
          
-              if(yield_here<cp_tree_edge>::value) yield m_cp = cp_tree_edge;
+              if(yield_here<cp_tree_edge>::value && emit(cp_tree_edge)) yield;
                               
               relax_target_confident(m_e, m_graph, m_edge_weight, m_vertex_predecessor, 
                 m_vertex_distance, m_distance_combine); 
         
               m_graph_visitor.edge_relaxed(m_e, m_graph);
-              if(yield_here<cp_edge_relaxed>::value) yield  m_cp = cp_edge_relaxed;
+              if(yield_here<cp_edge_relaxed>::value && emit(cp_edge_relaxed)) yield;
                            
               m_graph_visitor.discover_vertex(m_v, m_graph);
-              if(yield_here<cp_discover_vertex>::value) yield m_cp = cp_discover_vertex;
+              if(yield_here<cp_discover_vertex>::value && emit(cp_discover_vertex)) yield;
                     
               put(m_vertex_color, m_v, color_traits::gray());       
               m_max_priority_queue.push(m_v);
           
             } else {
                 
-              if(yield_here<cp_non_tree_edge>::value) yield m_cp = cp_non_tree_edge;
+              if(yield_here<cp_non_tree_edge>::value && emit(cp_non_tree_edge)) yield;
                        
               if (v_color == color_traits::gray()){
                   
-                if(yield_here<cp_gray_target>::value) yield m_cp = cp_gray_target;
+                if(yield_here<cp_gray_target>::value && emit(cp_gray_target)) yield;
               
-                decreased = relax_target(m_e, m_graph, m_edge_weight, m_vertex_predecessor, 
+                decreased = blink::relax_target(m_e, m_graph, m_edge_weight, m_vertex_predecessor, 
                   m_vertex_distance, m_distance_combine, m_distance_compare); 
         
                 if (decreased) {
                   m_max_priority_queue.update(m_v);
    
                   m_graph_visitor.edge_relaxed(m_e, m_graph);
-                  if(yield_here<cp_edge_relaxed>::value) yield m_cp = cp_edge_relaxed;
+                  if(yield_here<cp_edge_relaxed>::value && emit(cp_edge_relaxed)) yield;
                        
                 } else {
                   
                   m_graph_visitor.edge_not_relaxed(m_e, m_graph);
-                  if(yield_here<cp_edge_not_relaxed>::value) yield  m_cp = cp_edge_not_relaxed;
+                  if(yield_here<cp_edge_not_relaxed>::value && emit(cp_edge_not_relaxed)) yield;
                        
                 }
               } else { // v_color = black
                 
-                  if(yield_here<cp_black_target>::value) yield m_cp = cp_black_target;
+                  if(yield_here<cp_black_target>::value && emit(cp_black_target)) yield;
                      
               }
             }
@@ -194,7 +272,7 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
           put(m_vertex_color, m_u, color_traits::black()); 
           m_graph_visitor.finish_vertex(m_u, m_graph);
             
-          if(yield_here<cp_finish_vertex>::value) yield m_cp = cp_finish_vertex;
+          if(yield_here<cp_finish_vertex>::value && emit(cp_finish_vertex)) yield;
                
         } // end while
         m_cp = cp_invalid;
@@ -216,6 +294,10 @@ struct dijkstra_object : dijkstra_state_mixin<DijkstraState>
 
   // This is input
   const SourceRange& m_source_range;
+
+  // The buffer filled by fill()
+  event_type* m_buffer;
+  event_type* m_buffer_end;
     
   // The stackless coroutine that allows resuming the algorithm
   boost::asio::coroutine m_coro;
@@ -232,7 +314,7 @@ struct dijkstra_object_helper : protected dijkstra_state_helper<Graph, Params>
    
   BOOST_STATIC_ASSERT(boost::is_same<Params, params_bgl >::value);
 
-  typedef typename dijkstra_state_helper<Graph, params_bgl> parent;
+  typedef dijkstra_state_helper<Graph, params_bgl> parent;
 
   template<typename Tag>
   struct param : parent::template param<Tag> 
@@ -241,7 +323,7 @@ struct dijkstra_object_helper : protected dijkstra_state_helper<Graph, Params>
   // The dijkstra_state with all template parameters resolved
   typedef typename  parent::type dijkstra_state_type;
  
-  typedef typename dijkstra_object<dijkstra_state_type, SourceRange, ControlMap> type;
+  typedef dijkstra_object<dijkstra_state_type, SourceRange, ControlMap> type;
  
   static type make(
     const Graph& g, SourceRange& source_range, const params_bgl& params)
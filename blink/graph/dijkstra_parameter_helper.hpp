@@ -87,6 +87,39 @@ public:
   typedef typename is_ptr<T, has_element>::unwrapped unwrapped;
 };
 
+// The edge_bundled type of the graph, or no_property if it has none.
+// Graphs like compressed_sparse_row_graph keep a property<> list as bundle.
+template<typename Graph>
+struct edge_bundle_or_none
+{
+private:
+  typedef char yes[1];
+  typedef char no[2];
+
+  template <typename C>
+  static yes& has_edge_bundled(typename C::edge_bundled*);
+
+  template <typename>
+  static no& has_edge_bundled(...);
+
+  static const bool has_bundle
+    = sizeof(has_edge_bundled<Graph>(0)) == sizeof(yes);
+
+  template<typename G, bool HasBundle>
+  struct bundle
+  {
+    typedef boost::no_property type;
+  };
+
+  template<typename G>
+  struct bundle<G, true>
+  {
+    typedef typename G::edge_bundled type;
+  };
+public:
+  typedef typename bundle<Graph, has_bundle>::type type;
+};
+
 // Only used for max_priority_queue to determine whether it is wrapped in a 
 // reference or a shared_pointer
 template<typename RawType>
@@ -126,7 +159,7 @@ struct dijkstra_parameter_helper
         
   BOOST_STATIC_ASSERT(is_bgl_named_params::value);
 
-  typedef typename dijkstra_parameter_helper<Graph, Params> this_type;
+  typedef dijkstra_parameter_helper<Graph, Params> this_type;
   typedef typename boost::graph_traits<Graph>::vertex_descriptor vertex_descriptor;
   typedef boost::is_base_and_derived<boost::vertex_list_graph_tag,
     typename boost::graph_traits<Graph>::traversal_category>
@@ -146,19 +179,19 @@ struct dijkstra_parameter_helper
 
   
   // find the parameter type for a Tag in the parameter pack
-  template<typename Tag> 
+  template<typename Tag, typename Dummy = void> 
   struct given_param 
   {
     typedef typename boost::get_param_type<Tag, Params>::type stored_type;
-    typedef typename stored_val_tag stored_type_tag;
-    typedef typename stored_type type;
+    typedef stored_val_tag stored_type_tag;
+    typedef stored_type type;
   };
 
   // find the parameter type for a Tag in the parameter pack
   // the bgl library put a reference wrapper around the max_priority_queue_t parameter.
   // make sure this is accounted for
-  template<> 
-    struct given_param<boost::max_priority_queue_t> 
+  template<typename Dummy> 
+    struct given_param<boost::max_priority_queue_t, Dummy> 
   {
     typedef typename boost::get_param_type<boost::max_priority_queue_t, Params>::type stored_type;
     typedef typename boost::unwrap_reference<stored_type>::type type;
@@ -209,18 +242,18 @@ struct dijkstra_parameter_helper
     /*
     boost::mpl::eval_if<
       typename is_given<Tag>::type, 
-      typename get_given_type<Tag>,
-      typename get_default_type<Tag> >::type type;
+      get_given_type<Tag>,
+      get_default_type<Tag> >::type type;
 
     typedef typename boost::mpl::eval_if<
       typename is_given<Tag>::type, 
-      typename get_given_stored_type<Tag>,
-      typename get_default_stored_type<Tag> >::type stored_type;
+      get_given_stored_type<Tag>,
+      get_default_stored_type<Tag> >::type stored_type;
 
     typedef typename boost::mpl::eval_if<
       typename is_given<Tag>::type,
-      typename get_given_stored_type_tag<Tag>,
-      typename get_default_stored_type_tag<Tag> >::type stored_type_tag;
+      get_given_stored_type_tag<Tag>,
+      get_default_stored_type_tag<Tag> >::type stored_type_tag;
       */
 //    typedef typename boost::mpl::if_<
 //      typename is_given<Tag>::type, 
@@ -241,8 +274,10 @@ struct dijkstra_parameter_helper
   struct has_edge_property
   {
     typedef typename boost::edge_property_type<Graph>::type edge_properties;
+    typedef typename edge_bundle_or_none<Graph>::type edge_bundle;
     typedef typename boost::is_same<typename boost::property_value<edge_properties, Tag >::type, void>::type not_exist_type;
-    const static bool value = !not_exist_type::value;
+    typedef typename boost::is_same<typename boost::property_value<edge_bundle, Tag >::type, void>::type not_in_bundle_type;
+    const static bool value = !not_exist_type::value || !not_in_bundle_type::value;
   };
 
   template<typename Tag>
@@ -479,7 +514,7 @@ struct dijkstra_parameter_helper
     return default_param<Tag, void>::make(a, b, c, d);
   }
 
-  template<typename Tag, typename Params, typename A, typename B, typename C>
+  template<typename Tag, typename A, typename B, typename C>
   static typename param<Tag>::stored_type make_helper(Tag tag, const Params& params,
     const A&, const B&, const C&, boost::true_type)
   {
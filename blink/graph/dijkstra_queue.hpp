@@ -16,6 +16,9 @@
 #ifndef BLINK_GRAPH_DIJKSTRA_QUEUE_HPP
 #define BLINK_GRAPH_DIJKSTRA_QUEUE_HPP
 
+#include <blink/graph/cow_dijkstra_queue.hpp>
+#include <blink/graph/property_maps/cow_vector_property_map.hpp>
+
 #include <boost/graph/detail/d_ary_heap.hpp>
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/properties.hpp> // color_traits
@@ -70,6 +73,28 @@ void clear(Queue& queue)
   return clear(queue, has());
 }
  
+// Scans all vertices, see frontier_tracking_queue.hpp for an O(frontier) 
+// alternative.
+template<typename Graph, typename ColorMap, typename DijkstraQueue>
+void reset_dijkstra_queue_by_colormap(
+      ColorMap colormap,  
+      const Graph& graph,
+    DijkstraQueue& queue)
+{
+  typedef typename boost::graph_traits<Graph>::vertex_iterator vertex_iterator;
+  typedef typename boost::property_traits<ColorMap>::value_type color_type;
+  typedef boost::color_traits<color_type> color_traits;
+  
+  clear(queue);
+  
+  vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = vertices(graph); vi != vi_end; ++vi) {
+    if(get(colormap, *vi) == color_traits::gray()) {
+      queue.push(*vi); 
+    } 
+  }
+}
+
 template <typename Graph, typename DistanceMap, typename IndexMap,
   typename Compare>
 struct dijkstra_queue_bgl   
@@ -97,28 +122,55 @@ struct dijkstra_queue_bgl
     return type(distance, index_in_heap_map(num_vertices(graph), indexmap)
       , compare);
   }
-};
 
+  // A queue for a fork of a search, with the gray vertices. O(V), as it
+  // allocates the index in heap map and scans the color map.
+  template<typename ColorMap>
+  static boost::shared_ptr<type> fork_smart(const type&, const Graph& graph, 
+    DistanceMap distance, Compare compare, IndexMap indexmap, ColorMap color)
+  {
+    boost::shared_ptr<type> queue = make_smart(graph, distance, compare, 
+      indexmap);
+    reset_dijkstra_queue_by_colormap(color, graph, *queue);
+    return queue;
+  }
+};
 
-template<typename Graph, typename ColorMap, typename DijkstraQueue>
-void reset_dijkstra_queue_by_colormap(
-      ColorMap colormap,  
-      const Graph& graph,
-    DijkstraQueue& queue)
+// Searches with cow_vector_property_map distances get a cow_dijkstra_queue,
+// that fork_smart copies in O(frontier).
+template <typename Graph, typename T, typename DistanceIndexMap, 
+  typename IndexMap, typename Compare>
+struct dijkstra_queue_bgl<Graph, cow_vector_property_map<T, DistanceIndexMap>,
+  IndexMap, Compare>
 {
-  typedef typename boost::graph_traits<Graph>::vertex_iterator vertex_iterator;
-  typedef typename boost::property_traits<ColorMap>::value_type color_type;
-  typedef boost::color_traits<color_type> color_traits;
-  
-  clear(queue);
-  
-  vertex_iterator vi, vi_end;
-  for (boost::tie(vi, vi_end) = boost::vertices(graph); vi != vi_end; ++vi) {
-    if(get(colormap, *vi) == color_traits::gray()) {
-      queue.push(*vi); 
-    } 
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor vertex_descriptor;
+  typedef cow_vector_property_map<T, DistanceIndexMap> distance_map;
+  typedef cow_dijkstra_queue<vertex_descriptor, distance_map, IndexMap, 
+    Compare> type;
+  typedef typename type::index_in_heap_map index_in_heap_map;
+
+  static boost::shared_ptr<type> make_smart(const Graph& graph, 
+    distance_map distance, Compare compare, IndexMap indexmap)
+  {
+    return boost::shared_ptr<type>(new type(make(graph, distance, compare, 
+      indexmap)));
   }
-}
+
+  static type make(const Graph& graph, distance_map distance, Compare compare,
+    IndexMap indexmap)
+  {
+    return type(distance, index_in_heap_map(num_vertices(graph), indexmap, 
+      std::size_t(-1)), compare);
+  }
+
+  template<typename ColorMap>
+  static boost::shared_ptr<type> fork_smart(const type& queue, const Graph&, 
+    distance_map distance, Compare, IndexMap, ColorMap)
+  {
+    return boost::shared_ptr<type>(new type(queue.fork(distance)));
+  }
+};
+
 }; // namespace blink
 
 
@@ -0,0 +1,264 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// A least-recently-used cache of live searches, keyed by source. A query
+// for a target that the cached search has already finished is answered
+// from its maps, otherwise the search is resumed until the target is
+// finished. Searches are taken from a dijkstra_state_pool, evicting one
+// returns it to the pool for the next miss.
+//
+// The cache is not thread-safe.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_SEARCH_CACHE_HPP
+#define BLINK_GRAPH_DIJKSTRA_SEARCH_CACHE_HPP
+
+#include <blink/graph/dijkstra_state_pool.hpp>
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/named_function_params.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility> // move
+
+namespace blink {
+
+struct dijkstra_search_cache_statistics
+{
+  dijkstra_search_cache_statistics()
+    : hits(0), resumes(0), misses(0), evictions(0)
+  {}
+
+  double hit_rate() const
+  {
+    const std::size_t queries = hits + resumes + misses;
+    return queries == 0 ? 0.0 : double(hits) / double(queries);
+  }
+
+  std::size_t hits;      // target was already finished
+  std::size_t resumes;   // source was cached, search was resumed
+  std::size_t misses;    // source was not cached
+  std::size_t evictions;
+};
+
+namespace detail {
+
+// Interrupts the search once the target is finished
+template<typename Vertex>
+class finish_target_visitor : public boost::default_dijkstra_visitor
+{
+public:
+  finish_target_visitor(Vertex target)
+    : m_target(target), m_do_interrupt(new bool(false))
+  {}
+
+  template<typename U, typename G>
+  void finish_vertex(const U& u, const G& g)
+  {
+    if (u == m_target) {
+      *m_do_interrupt = true;
+    }
+  }
+
+  inline bool do_interrupt() const
+  {
+    return *m_do_interrupt;
+  }
+
+private:
+  Vertex m_target;
+  boost::shared_ptr<bool> m_do_interrupt;
+};
+
+} // namespace detail
+
+// The Params are used to make the searches, see dijkstra_state_pool.
+template<typename Graph, typename Params = boost::no_named_parameters>
+class dijkstra_search_cache : boost::noncopyable
+{
+public:
+  typedef dijkstra_state_pool<Graph, Params> state_pool_type;
+  typedef typename state_pool_type::dijkstra_type dijkstra_type;
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor
+    vertex_descriptor;
+  typedef typename dijkstra_type::template param<boost::vertex_distance_t>
+    ::type distance_map_type;
+  typedef typename boost::property_traits<distance_map_type>::value_type
+    distance_type;
+
+  // Keeps as many searches as fit in memory_budget bytes, at least one. The
+  // first search is made up front, to take the vertex index map from it.
+  dijkstra_search_cache(const Graph& graph, std::size_t memory_budget,
+    const Params& params = Params())
+    : m_graph(graph), m_pool(graph, 0, params)
+    , m_vertex_index(m_pool.acquire()->get(boost::vertex_index_t()))
+  {
+    const std::size_t per_search = bytes_per_search();
+    m_capacity = per_search == 0 ? 1 : memory_budget / per_search;
+    if (m_capacity == 0) {
+      m_capacity = 1;
+    }
+  }
+
+  // The search from source with target finished, or with an empty queue if
+  // target cannot be reached. The reference is valid until the next query.
+  dijkstra_type& settle(vertex_descriptor source, vertex_descriptor target)
+  {
+    dijkstra_type& dijkstra = lookup(source, target);
+    if (!is_finished(dijkstra, target)) {
+      detail::finish_target_visitor<vertex_descriptor> visitor(target);
+      dijkstra.expand(visitor, visitor);
+    }
+    return dijkstra;
+  }
+
+  // The shortest path distance, inf if the target cannot be reached
+  distance_type distance(vertex_descriptor source, vertex_descriptor target)
+  {
+    dijkstra_type& dijkstra = settle(source, target);
+    if (!is_finished(dijkstra, target)) {
+      return dijkstra.get(boost::distance_inf_t());
+    }
+    return get(dijkstra.get(boost::vertex_distance_t()), target);
+  }
+
+  bool contains(vertex_descriptor source) const
+  {
+    return m_index.find(key(source)) != m_index.end();
+  }
+
+  // Evict all searches
+  void clear()
+  {
+    m_statistics.evictions += m_entries.size();
+    m_index.clear();
+    m_entries.clear();
+  }
+
+  std::size_t size() const
+  {
+    return m_entries.size();
+  }
+
+  std::size_t capacity() const
+  {
+    return m_capacity;
+  }
+
+  const dijkstra_search_cache_statistics& statistics() const
+  {
+    return m_statistics;
+  }
+
+  void reset_statistics()
+  {
+    m_statistics = dijkstra_search_cache_statistics();
+  }
+
+  // An estimate of the memory held by a search: distance, heap index,
+  // color and predecessor (unless it is a null map) per vertex, a full 
+  // queue and a full discovery list of the pool.
+  std::size_t bytes_per_search() const
+  {
+    typedef typename dijkstra_type::template param<
+      boost::vertex_predecessor_t>::type predecessor_map_type;
+    const bool has_predecessor = !boost::is_same<predecessor_map_type,
+      boost::null_property_map<vertex_descriptor, vertex_descriptor> >::value;
+
+    const std::size_t per_vertex = sizeof(distance_type)
+      + 2 * sizeof(std::size_t) + 1 + sizeof(vertex_descriptor)
+      + (has_predecessor ? sizeof(vertex_descriptor) : 0);
+    return per_vertex * num_vertices(m_graph);
+  }
+
+private:
+  typedef typename state_pool_type::handle handle_type;
+  typedef typename dijkstra_type::template param<boost::vertex_index_t>::type
+    vertex_index_map_type;
+
+  struct entry
+  {
+    entry(vertex_descriptor source, handle_type&& search)
+      : m_source(source), m_search(std::move(search))
+    {}
+
+    vertex_descriptor m_source;
+    handle_type m_search;
+  };
+
+  typedef std::list<entry> entry_list; // most recently used first
+  typedef std::unordered_map<std::size_t,
+    typename entry_list::iterator> index_type;
+
+  std::size_t key(vertex_descriptor v) const
+  {
+    return get(m_vertex_index, v);
+  }
+
+  static bool is_finished(const dijkstra_type& dijkstra, vertex_descriptor v)
+  {
+    typedef typename dijkstra_type::template param<boost::vertex_color_t>
+      ::type color_map_type;
+    typedef typename boost::property_traits<color_map_type>::value_type
+      color_type;
+    return get(dijkstra.get(boost::vertex_color_t()), v)
+      == boost::color_traits<color_type>::black();
+  }
+
+  dijkstra_type& lookup(vertex_descriptor source, vertex_descriptor target)
+  {
+    typename index_type::iterator i = m_index.find(key(source));
+    if (i != m_index.end()) {
+      m_entries.splice(m_entries.begin(), m_entries, i->second);
+      dijkstra_type& dijkstra = *m_entries.front().m_search;
+      if (is_finished(dijkstra, target)) {
+        ++m_statistics.hits;
+      } else {
+        ++m_statistics.resumes;
+      }
+      return dijkstra;
+    }
+
+    ++m_statistics.misses;
+    if (m_entries.size() >= m_capacity) {
+      m_index.erase(key(m_entries.back().m_source));
+      m_entries.pop_back(); // returns the search to the pool
+      ++m_statistics.evictions;
+    }
+    m_entries.push_front(entry(source, m_pool.acquire()));
+    m_index[key(source)] = m_entries.begin();
+
+    dijkstra_type& dijkstra = *m_entries.front().m_search;
+    dijkstra.put_source(source);
+    return dijkstra;
+  }
+
+  const Graph& m_graph;
+  state_pool_type m_pool; // must outlive m_entries
+  vertex_index_map_type m_vertex_index;
+  entry_list m_entries;
+  index_type m_index;
+  std::size_t m_capacity;
+  dijkstra_search_cache_statistics m_statistics;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_DIJKSTRA_SEARCH_CACHE_HPP
@@ -18,6 +18,7 @@
 #include <blink/graph/breadth_first_search.hpp>
 #include <blink/graph/relax.hpp>
 
+#include <boost/graph/exception.hpp> // negative_edge
 #include <boost/property_map/property_map.hpp>
 
 
@@ -50,7 +51,7 @@ struct dijkstra_bfs_visitor
       
   template <class Edge, class Graph>
   void gray_target(Edge e, Graph& g) {
-    bool decreased = relax_target(e, g, m_weight, m_predecessor, m_distance,
+    bool decreased = blink::relax_target(e, g, m_weight, m_predecessor, m_distance,
                           m_combine, m_compare);
     if (decreased) {
       m_Q.update(target(e, g));
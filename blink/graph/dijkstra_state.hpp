@@ -33,7 +33,7 @@ template< typename Graph, typename EdgeWeight, typename VertexIndex
 struct dijkstra_state
 {
 private: 
-	typedef typename MaxPriorityQueue queue_stored_type;
+	typedef MaxPriorityQueue queue_stored_type;
 	typedef typename processed_type<queue_stored_type>::type queue_type;
 	typedef typename processed_type<queue_stored_type>::stored_type_tag queue_stored_type_tag;
 
@@ -52,18 +52,19 @@ public:
 	
 	typedef Graph graph_type;
 
-	template<typename Tag> struct param {};
-	template<> struct param<boost::edge_weight_t>        { typedef EdgeWeight        type; };
-	template<> struct param<boost::vertex_index_t>       { typedef VertexIndex       type; };
-	template<> struct param<boost::vertex_distance_t>    { typedef VertexDistance    type; };
-	template<> struct param<boost::vertex_predecessor_t> { typedef VertexPredecessor type; };
-	template<> struct param<boost::vertex_color_t>       { typedef VertexColor       type; };
-	template<> struct param<boost::distance_compare_t>   { typedef DistanceCompare   type; };
-	template<> struct param<boost::distance_combine_t>   { typedef DistanceCombine   type; };
-	template<> struct param<boost::distance_inf_t>       { typedef DistanceInf       type; };
-	template<> struct param<boost::distance_zero_t>      { typedef DistanceZero      type; };
-	template<> struct param<boost::graph_visitor_t>      { typedef GraphVisitor      type; };
-	template<> struct param<boost::max_priority_queue_t> { typedef queue_type        type; };
+	// Partial specializations, explicit ones are not allowed in class scope
+	template<typename Tag, typename Dummy = void> struct param {};
+	template<typename D> struct param<boost::edge_weight_t, D>        { typedef EdgeWeight        type; };
+	template<typename D> struct param<boost::vertex_index_t, D>       { typedef VertexIndex       type; };
+	template<typename D> struct param<boost::vertex_distance_t, D>    { typedef VertexDistance    type; };
+	template<typename D> struct param<boost::vertex_predecessor_t, D> { typedef VertexPredecessor type; };
+	template<typename D> struct param<boost::vertex_color_t, D>       { typedef VertexColor       type; };
+	template<typename D> struct param<boost::distance_compare_t, D>   { typedef DistanceCompare   type; };
+	template<typename D> struct param<boost::distance_combine_t, D>   { typedef DistanceCombine   type; };
+	template<typename D> struct param<boost::distance_inf_t, D>       { typedef DistanceInf       type; };
+	template<typename D> struct param<boost::distance_zero_t, D>      { typedef DistanceZero      type; };
+	template<typename D> struct param<boost::graph_visitor_t, D>      { typedef GraphVisitor      type; };
+	template<typename D> struct param<boost::max_priority_queue_t, D> { typedef queue_type        type; };
 
   EdgeWeight&        get(const boost::edge_weight_t&)         { return m_edge_weight; }
 	VertexIndex&       get(const boost::vertex_index_t&)        { return m_vertex_index; }
@@ -135,10 +136,10 @@ private:
 template<typename Graph, typename Params>
 struct dijkstra_state_helper : protected dijkstra_parameter_helper<Graph, Params>
 {
-  typedef typename dijkstra_parameter_helper<Graph, Params> parent;
+  typedef dijkstra_parameter_helper<Graph, Params> parent;
     
   template<typename Tag>
-  struct param : parent::param<Tag>
+  struct param : parent::template param<Tag>
   {};
     
   typedef dijkstra_state<Graph
@@ -157,38 +158,38 @@ struct dijkstra_state_helper : protected dijkstra_parameter_helper<Graph, Params
     
   static type make(const Graph& g, const Params& params)
   {
-    parent::param<boost::edge_weight_t>::stored_type edge_weight_map 
+    typename parent::template param<boost::edge_weight_t>::stored_type edge_weight_map 
       = parent::make(boost::edge_weight_t(), params, g);
 
-    parent::param<boost::vertex_index_t>::stored_type vertex_index_map 
+    typename parent::template param<boost::vertex_index_t>::stored_type vertex_index_map 
       = parent::make(boost::vertex_index_t(), params,  g);
 
-    parent::param<boost::vertex_distance_t>::stored_type vertex_distance_map 
+    typename parent::template param<boost::vertex_distance_t>::stored_type vertex_distance_map 
       = parent::make(boost::vertex_distance_t(), params, g, vertex_index_map);
 
-    parent::param<boost::vertex_predecessor_t>::stored_type  vertex_predecessor_map 
+    typename parent::template param<boost::vertex_predecessor_t>::stored_type  vertex_predecessor_map 
       = parent::make(boost::vertex_predecessor_t(), params);
 
-    parent::param<boost::vertex_color_t>::stored_type vertex_color_map 
+    typename parent::template param<boost::vertex_color_t>::stored_type vertex_color_map 
       = parent::make(boost::vertex_color_t(), params, g, vertex_index_map);
   
-    parent::param<boost::distance_compare_t>::stored_type comparison_object 
+    typename parent::template param<boost::distance_compare_t>::stored_type comparison_object 
       = parent::make(boost::distance_compare_t(), params);
 
-    parent::param<boost::distance_inf_t>::stored_type distance_inf_value 
+    typename parent::template param<boost::distance_inf_t>::stored_type distance_inf_value 
       = parent::make(boost::distance_inf_t(), params);
   
-    parent::param<boost::distance_combine_t>::stored_type combine_object 
+    typename parent::template param<boost::distance_combine_t>::stored_type combine_object 
       = parent::make(boost::distance_combine_t(), params, distance_inf_value);
     
-    parent::param<boost::distance_zero_t>::stored_type distance_zero_value 
+    typename parent::template param<boost::distance_zero_t>::stored_type distance_zero_value 
       = parent::make(boost::distance_zero_t(), params);
   
-    parent::param<boost::max_priority_queue_t>::stored_type max_priority_queue_object 
+    typename parent::template param<boost::max_priority_queue_t>::stored_type max_priority_queue_object 
       = parent::make(boost::max_priority_queue_t(), params, g, 
       vertex_distance_map, comparison_object, vertex_index_map);
 
-    parent::param<boost::graph_visitor_t>::stored_type visitor 
+    typename parent::template param<boost::graph_visitor_t>::stored_type visitor 
       = parent::make(boost::graph_visitor_t(), params);
 
     return type(g, edge_weight_map, vertex_index_map, 
@@ -247,14 +248,14 @@ protected:
   typedef typename param<boost::distance_inf_t        >::type distance_inf_type;
   typedef typename param<boost::distance_zero_t       >::type distance_zero_type;
   typedef typename param<boost::edge_weight_t         >::type edge_weight_type;
-  typedef typename param<boost::max_priority_queue_t>  ::type max_priority_queue_type;
+  typedef typename param<boost::max_priority_queue_t  >::type max_priority_queue_type;
   typedef typename param<boost::vertex_color_t        >::type vertex_color_type;
   typedef typename param<boost::vertex_distance_t     >::type vertex_distance_type;
   typedef typename param<boost::vertex_index_t        >::type vertex_index_type;
   typedef typename param<boost::vertex_predecessor_t  >::type vertex_predecessor_type;
   typedef typename param<boost::graph_visitor_t       >::type graph_visitor_type;
 
-  typedef typename boost::graph_traits<graph_type> graph_traits;
+  typedef boost::graph_traits<graph_type> graph_traits;
   typedef typename graph_traits::vertex_descriptor vertex_descriptor;
   typedef typename graph_traits::vertex_iterator   vertex_iterator;
   typedef typename graph_traits::edge_descriptor   edge_descriptor;
@@ -263,7 +264,7 @@ protected:
   typedef typename boost::property_traits<vertex_distance_type>::value_type distance_type;
   typedef typename boost::property_traits<vertex_color_type   >::value_type color_type;
 
-  typedef typename boost::color_traits<color_type> color_traits;
+  typedef boost::color_traits<color_type> color_traits;
 
 public:
 
@@ -281,18 +282,18 @@ public:
   template<typename Tag>
   typename param<Tag>::type& get(Tag tag = Tag())
   {
-    return m_dijkstra_state->get<Tag>();
+    return m_dijkstra_state->template get<Tag>();
   }
 
   template<typename Tag>
   const typename param<Tag>::type& get(Tag tag = Tag()) const
   {
-    return m_dijkstra_state->get<Tag>();
+    return m_dijkstra_state->template get<Tag>();
   }
 
   inline const graph_type& get_graph() const
   {
-    return graph;
+    return m_graph;
   }
 
 private:
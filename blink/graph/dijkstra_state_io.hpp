@@ -0,0 +1,476 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// save_state and load_state write a paused dijkstra_state to a binary
+// snapshot and read it back, so that the search can be resumed in another
+// process. Only the non-white vertices are written: first the black ones
+// by vertex index, then the gray ones (the queue) by distance. The queue is
+// restored by pushing the gray vertices in that order, which does not move
+// any element, instead of scanning all vertices like
+// reset_dijkstra_queue_by_colormap.
+//
+// Layout, integers little-endian:
+//   "BLKS", version (1 byte), flags (1 byte), sizeof distance (1 byte),
+//   reserved (1 byte), num_vertices (8 bytes), num_black (8 bytes),
+//   num_gray (8 bytes), then per vertex record:
+//   index, distance, predecessor index (if flagged)
+// With the compact flag, indices are written as variable length integers
+// and black indices as the difference with the previous one. Distances of
+// arithmetic type are little-endian too, other distance types are written
+// as their raw bytes, so those snapshots are host-endian.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_STATE_IO_HPP
+#define BLINK_GRAPH_DIJKSTRA_STATE_IO_HPP
+
+#include <boost/cstdint.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/named_function_params.hpp> // max_priority_queue_t
+#include <boost/graph/properties.hpp> // color_traits
+#include <boost/predef/other/endian.h>
+#include <boost/property_map/property_map.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/tuple/tuple.hpp> //tie
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+
+#include <algorithm> // reverse, sort
+#include <cstddef>
+#include <cstring> // memcpy
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace blink {
+
+// Options for save_state
+enum state_io_flags
+{
+  state_io_compact = 1,       // variable length indices
+  state_io_predecessors = 2   // set by save_state when the predecessor map
+                              // is not null
+};
+
+namespace detail {
+
+template<typename Map>
+struct is_null_property_map : boost::false_type
+{};
+
+template<typename Key, typename Value>
+struct is_null_property_map<boost::null_property_map<Key, Value> >
+  : boost::true_type
+{};
+
+const unsigned char state_io_version = 1;
+
+// Reverse the bytes of an arithmetic value on big-endian hosts, so that it
+// is stored little-endian. Other types are kept as they are.
+template<typename T>
+void swap_to_little_endian(T& x, boost::true_type)
+{
+#if BOOST_ENDIAN_BIG_BYTE
+  unsigned char* b = reinterpret_cast<unsigned char*>(&x);
+  std::reverse(b, b + sizeof(T));
+#else
+  (void)x;
+#endif
+}
+
+template<typename T>
+void swap_to_little_endian(T&, boost::false_type)
+{}
+
+template<typename T>
+void swap_to_little_endian(T& x)
+{
+  swap_to_little_endian(x, typename boost::is_arithmetic<T>::type());
+}
+
+class state_writer
+{
+public:
+  state_writer(std::ostream& os) : m_os(&os)
+  {}
+
+  void bytes(const void* data, std::size_t n)
+  {
+    m_os->write(static_cast<const char*>(data), n);
+  }
+
+  void u8(unsigned char c)
+  {
+    bytes(&c, 1);
+  }
+
+  void u64(boost::uint64_t x)
+  {
+    unsigned char b[8];
+    for (int i = 0; i < 8; ++i) {
+      b[i] = static_cast<unsigned char>(x >> (8 * i));
+    }
+    bytes(b, 8);
+  }
+
+  void varint(boost::uint64_t x)
+  {
+    while (x >= 0x80) {
+      u8(static_cast<unsigned char>(x | 0x80));
+      x >>= 7;
+    }
+    u8(static_cast<unsigned char>(x));
+  }
+
+  void index(boost::uint64_t x, bool compact)
+  {
+    if (compact) {
+      varint(x);
+    } else {
+      u64(x);
+    }
+  }
+
+private:
+  std::ostream* m_os;
+};
+
+class stream_reader
+{
+public:
+  stream_reader(std::istream& is) : m_is(&is)
+  {}
+
+  void bytes(void* data, std::size_t n)
+  {
+    if (!m_is->read(static_cast<char*>(data), n)) {
+      boost::throw_exception(std::runtime_error("truncated dijkstra state"));
+    }
+  }
+
+private:
+  std::istream* m_is;
+};
+
+// Reads from memory, for instance a memory-mapped file
+class buffer_reader
+{
+public:
+  buffer_reader(const void* data, std::size_t size)
+    : m_pos(static_cast<const unsigned char*>(data)), m_end(m_pos + size)
+  {}
+
+  void bytes(void* data, std::size_t n)
+  {
+    if (std::size_t(m_end - m_pos) < n) {
+      boost::throw_exception(std::runtime_error("truncated dijkstra state"));
+    }
+    std::memcpy(data, m_pos, n);
+    m_pos += n;
+  }
+
+private:
+  const unsigned char* m_pos;
+  const unsigned char* m_end;
+};
+
+template<typename Reader>
+unsigned char read_u8(Reader& r)
+{
+  unsigned char c;
+  r.bytes(&c, 1);
+  return c;
+}
+
+template<typename Reader>
+boost::uint64_t read_u64(Reader& r)
+{
+  unsigned char b[8];
+  r.bytes(b, 8);
+  boost::uint64_t x = 0;
+  for (int i = 7; i >= 0; --i) {
+    x = (x << 8) | b[i];
+  }
+  return x;
+}
+
+template<typename Reader>
+boost::uint64_t read_varint(Reader& r)
+{
+  boost::uint64_t x = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    const unsigned char c = read_u8(r);
+    x |= boost::uint64_t(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      return x;
+    }
+  }
+  boost::throw_exception(std::runtime_error("corrupt dijkstra state"));
+  return x;
+}
+
+template<typename Reader>
+boost::uint64_t read_index(Reader& r, bool compact)
+{
+  return compact ? read_varint(r) : read_u64(r);
+}
+
+template<typename IndexMap, typename PredecessorMap, typename Vertex>
+boost::uint64_t predecessor_index(const IndexMap& index,
+  const PredecessorMap& predecessor, const Vertex& v, boost::false_type)
+{
+  return get(index, get(predecessor, v));
+}
+
+// Not called, there are no predecessors to write
+template<typename IndexMap, typename PredecessorMap, typename Vertex>
+boost::uint64_t predecessor_index(const IndexMap&, const PredecessorMap&,
+  const Vertex&, boost::true_type)
+{
+  return 0;
+}
+
+// Orders vertices by distance, for the gray records
+template<typename DistanceMap, typename Compare>
+struct distance_order
+{
+  distance_order(DistanceMap distance, Compare compare)
+    : m_distance(distance), m_compare(compare)
+  {}
+
+  template<typename Vertex>
+  bool operator()(const Vertex& a, const Vertex& b) const
+  {
+    return m_compare(get(m_distance, a), get(m_distance, b));
+  }
+
+  DistanceMap m_distance;
+  Compare m_compare;
+};
+
+template<typename DijkstraState, typename Reader>
+void load_state(DijkstraState& state, Reader& reader)
+{
+  typedef typename DijkstraState::graph_type graph_type;
+  typedef typename boost::graph_traits<graph_type>::vertex_descriptor
+    vertex_descriptor;
+  typedef typename DijkstraState::template param<boost::vertex_distance_t>
+    ::type distance_map_type;
+  typedef typename boost::property_traits<distance_map_type>::value_type
+    distance_type;
+  typedef typename DijkstraState::template param<boost::vertex_color_t>
+    ::type color_map_type;
+  typedef typename boost::property_traits<color_map_type>::value_type
+    color_type;
+  typedef boost::color_traits<color_type> color_traits;
+  typedef typename DijkstraState::template param<boost::vertex_predecessor_t>
+    ::type predecessor_map_type;
+  typedef typename boost::graph_traits<graph_type>::vertex_iterator
+    vertex_iterator;
+
+  const graph_type& g = state.get_graph();
+  distance_map_type& distance = state.template get<boost::vertex_distance_t>();
+  color_map_type& color = state.template get<boost::vertex_color_t>();
+  predecessor_map_type& predecessor
+    = state.template get<boost::vertex_predecessor_t>();
+
+  if (!state.template get<boost::max_priority_queue_t>().empty()) {
+    boost::throw_exception(std::invalid_argument(
+      "load_state: the queue is not empty"));
+  }
+  vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    if (get(color, *vi) != color_traits::white()) {
+      boost::throw_exception(std::invalid_argument(
+        "load_state: not all vertices are white"));
+    }
+  }
+
+  char magic[4];
+  reader.bytes(magic, 4);
+  if (std::memcmp(magic, "BLKS", 4) != 0
+    || read_u8(reader) != state_io_version) {
+    boost::throw_exception(std::runtime_error("not a dijkstra state"));
+  }
+  const unsigned char flags = read_u8(reader);
+  const bool compact = (flags & state_io_compact) != 0;
+  const bool predecessors = (flags & state_io_predecessors) != 0;
+  const unsigned char distance_size = read_u8(reader);
+  read_u8(reader);
+  const boost::uint64_t n = read_u64(reader);
+  if (distance_size != sizeof(distance_type) || n != num_vertices(g)) {
+    boost::throw_exception(std::runtime_error(
+      "dijkstra state does not match graph"));
+  }
+  const boost::uint64_t num_black = read_u64(reader);
+  const boost::uint64_t num_gray = read_u64(reader);
+  if (num_black > n || num_gray > n || num_black + num_gray > n) {
+    boost::throw_exception(std::runtime_error("corrupt dijkstra state"));
+  }
+
+  // Read and check all records before the state is changed
+  const std::size_t num_records = static_cast<std::size_t>(num_black + num_gray);
+  std::vector<boost::uint64_t> indices(num_records);
+  std::vector<distance_type> distances(num_records);
+  std::vector<boost::uint64_t> parents(predecessors ? num_records : 0);
+  std::vector<bool> seen(static_cast<std::size_t>(n), false);
+  boost::uint64_t index = 0;
+  for (std::size_t k = 0; k < num_records; ++k) {
+    const bool black = k < num_black;
+    const boost::uint64_t i = read_index(reader, compact);
+    index = black && compact ? index + i : i;
+    if (index >= n || seen[static_cast<std::size_t>(index)]) {
+      boost::throw_exception(std::runtime_error("corrupt dijkstra state"));
+    }
+    seen[static_cast<std::size_t>(index)] = true;
+    indices[k] = index;
+
+    reader.bytes(&distances[k], sizeof(distance_type));
+    swap_to_little_endian(distances[k]);
+
+    if (predecessors) {
+      parents[k] = read_index(reader, compact);
+      if (parents[k] >= n) {
+        boost::throw_exception(std::runtime_error("corrupt dijkstra state"));
+      }
+    }
+  }
+
+  for (std::size_t k = 0; k < num_records; ++k) {
+    const vertex_descriptor v = vertex(indices[k], g);
+    put(distance, v, distances[k]);
+    if (predecessors) {
+      put(predecessor, v, vertex(parents[k], g));
+    }
+    if (k < num_black) {
+      put(color, v, color_traits::black());
+    } else {
+      put(color, v, color_traits::gray());
+      state.template get<boost::max_priority_queue_t>().push(v);
+    }
+  }
+}
+
+} // namespace detail
+
+// Write the non-white vertices of the state. Flags is a combination of
+// state_io_flags. Predecessors are written whenever the predecessor map
+// is not a null_property_map, state_io_predecessors need not be given.
+template<typename DijkstraState>
+void save_state(DijkstraState& state, std::ostream& os,
+  unsigned int flags = 0)
+{
+  typedef typename DijkstraState::graph_type graph_type;
+  typedef typename boost::graph_traits<graph_type>::vertex_descriptor
+    vertex_descriptor;
+  typedef typename boost::graph_traits<graph_type>::vertex_iterator
+    vertex_iterator;
+  typedef typename DijkstraState::template param<boost::vertex_distance_t>
+    ::type distance_map_type;
+  typedef typename boost::property_traits<distance_map_type>::value_type
+    distance_type;
+  typedef typename DijkstraState::template param<boost::vertex_color_t>
+    ::type color_map_type;
+  typedef typename boost::property_traits<color_map_type>::value_type
+    color_type;
+  typedef boost::color_traits<color_type> color_traits;
+  typedef typename DijkstraState::template param<boost::vertex_predecessor_t>
+    ::type predecessor_map_type;
+  typedef typename DijkstraState::template param<boost::vertex_index_t>
+    ::type index_map_type;
+  typedef typename DijkstraState::template param<boost::distance_compare_t>
+    ::type compare_type;
+
+  const graph_type& g = state.get_graph();
+  distance_map_type& distance = state.template get<boost::vertex_distance_t>();
+  color_map_type& color = state.template get<boost::vertex_color_t>();
+  predecessor_map_type& predecessor
+    = state.template get<boost::vertex_predecessor_t>();
+  index_map_type& index = state.template get<boost::vertex_index_t>();
+
+  if (detail::is_null_property_map<predecessor_map_type>::value) {
+    flags &= ~unsigned(state_io_predecessors);
+  } else {
+    flags |= state_io_predecessors;
+  }
+  const bool compact = (flags & state_io_compact) != 0;
+  const bool predecessors = (flags & state_io_predecessors) != 0;
+
+  std::vector<vertex_descriptor> black, gray;
+  vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+    const color_type c = get(color, *vi);
+    if (c == color_traits::black()) {
+      black.push_back(*vi);
+    } else if (c == color_traits::gray()) {
+      gray.push_back(*vi);
+    }
+  }
+  std::sort(gray.begin(), gray.end(),
+    detail::distance_order<distance_map_type, compare_type>(distance,
+      state.template get<boost::distance_compare_t>()));
+
+  detail::state_writer writer(os);
+  writer.bytes("BLKS", 4);
+  writer.u8(detail::state_io_version);
+  writer.u8(static_cast<unsigned char>(flags));
+  writer.u8(sizeof(distance_type));
+  writer.u8(0);
+  writer.u64(num_vertices(g));
+  writer.u64(black.size());
+  writer.u64(gray.size());
+
+  boost::uint64_t previous = 0;
+  for (std::size_t k = 0; k < black.size() + gray.size(); ++k) {
+    const bool is_black = k < black.size();
+    const vertex_descriptor v = is_black ? black[k] : gray[k - black.size()];
+    const boost::uint64_t i = get(index, v);
+    writer.index(is_black && compact ? i - previous : i, compact);
+    previous = i;
+
+    distance_type d = get(distance, v);
+    detail::swap_to_little_endian(d);
+    writer.bytes(&d, sizeof(distance_type));
+
+    if (predecessors) {
+      writer.index(detail::predecessor_index(index, predecessor, v,
+        typename detail::is_null_property_map<predecessor_map_type>::type()),
+        compact);
+    }
+  }
+}
+
+// Restore a state written by save_state. The state must be for the same
+// graph, have an empty queue and all vertices white, as after init_all or
+// as made with the default color map; otherwise std::invalid_argument is
+// thrown. The vertices of the graph are looked up by index with
+// vertex(i, g). Throws std::runtime_error if the snapshot is corrupt or for
+// another graph. The whole snapshot is read and checked before the state
+// is changed, so on any exception the state is left as it was.
+template<typename DijkstraState>
+void load_state(DijkstraState& state, std::istream& is)
+{
+  detail::stream_reader reader(is);
+  detail::load_state(state, reader);
+}
+
+// Restore a state from memory, for instance a memory-mapped snapshot
+template<typename DijkstraState>
+void load_state(DijkstraState& state, const void* data, std::size_t size)
+{
+  detail::buffer_reader reader(data, size);
+  detail::load_state(state, reader);
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_DIJKSTRA_STATE_IO_HPP
@@ -0,0 +1,225 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// A thread-safe pool of resumable_dijkstra objects. Searches are handed out
+// initialized (all vertices white, empty queue) and are reset when they are
+// returned. The reset only visits the vertices that the search discovered,
+// these are recorded by the graph visitor of each pooled search. Maps and
+// queues are kept for reuse, so in steady state no memory is allocated or
+// freed.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_STATE_POOL_HPP
+#define BLINK_GRAPH_DIJKSTRA_STATE_POOL_HPP
+
+#include <blink/graph/dijkstra_queue.hpp> // clear
+#include <blink/graph/dijkstra_visitor/record_discovery_visitor.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/named_function_params.hpp>
+#include <boost/graph/properties.hpp> // color_traits
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <iterator> // back_insert_iterator
+#include <mutex>
+#include <vector>
+
+namespace blink {
+
+// The Params are used to make every pooled search. They must not hold
+// vertex property maps, a queue or a graph visitor, as those are owned
+// by the pooled search. Pooled searches should not be expanded with
+// expand_parallel, that does not report discovered vertices.
+template<typename Graph, typename Params = boost::no_named_parameters>
+class dijkstra_state_pool : boost::noncopyable
+{
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor
+    vertex_descriptor;
+  typedef std::vector<vertex_descriptor> discovery_list;
+  typedef record_discovery_visitor<std::back_insert_iterator<discovery_list> >
+    discovery_visitor;
+
+public:
+  typedef boost::bgl_named_params<discovery_visitor, boost::graph_visitor_t
+    , Params> params_type;
+  typedef typename resumable_dijkstra_helper<Graph, params_type>::type
+    dijkstra_type;
+
+private:
+  struct entry
+  {
+    discovery_list m_discovered;
+    boost::shared_ptr<dijkstra_type> m_dijkstra;
+  };
+
+public:
+  // Gives exclusive use of a pooled search, returns it to the pool on
+  // destruction. Movable, not copyable.
+  class handle
+  {
+  public:
+    handle() : m_pool(0), m_entry(0)
+    {}
+
+    handle(handle&& other) : m_pool(other.m_pool), m_entry(other.m_entry)
+    {
+      other.m_pool = 0;
+      other.m_entry = 0;
+    }
+
+    handle& operator=(handle&& other)
+    {
+      if (this != &other) {
+        release();
+        m_pool = other.m_pool;
+        m_entry = other.m_entry;
+        other.m_pool = 0;
+        other.m_entry = 0;
+      }
+      return *this;
+    }
+
+    ~handle()
+    {
+      release();
+    }
+
+    // Return the search to the pool before the handle is destroyed
+    void release()
+    {
+      if (m_entry) {
+        m_pool->release(m_entry);
+        m_pool = 0;
+        m_entry = 0;
+      }
+    }
+
+    dijkstra_type& operator*() const
+    {
+      return *m_entry->m_dijkstra;
+    }
+
+    dijkstra_type* operator->() const
+    {
+      return m_entry->m_dijkstra.get();
+    }
+
+  private:
+    friend class dijkstra_state_pool;
+
+    handle(const handle&);
+    handle& operator=(const handle&);
+
+    handle(dijkstra_state_pool* pool, entry* e) : m_pool(pool), m_entry(e)
+    {}
+
+    dijkstra_state_pool* m_pool;
+    entry* m_entry;
+  };
+
+  // Makes initial_size searches up front, more are made when the pool runs
+  // dry. The pool must outlive all handles.
+  dijkstra_state_pool(const Graph& graph, std::size_t initial_size = 0,
+    const Params& params = Params())
+    : m_graph(graph), m_params(params)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t i = 0; i < initial_size; ++i) {
+      m_idle.push_back(make_entry());
+    }
+  }
+
+  // The search has all vertices white and an empty queue, use put_source(s)
+  // and expand.
+  handle acquire()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_idle.empty()) {
+      return handle(this, make_entry());
+    }
+    entry* e = m_idle.back();
+    m_idle.pop_back();
+    return handle(this, e);
+  }
+
+  // The number of searches made by the pool
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+  }
+
+  // The number of searches that are not handed out
+  std::size_t idle() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_idle.size();
+  }
+
+private:
+  // Called with m_mutex locked
+  entry* make_entry()
+  {
+    boost::shared_ptr<entry> e(new entry);
+    params_type params(discovery_visitor(std::back_inserter(e->m_discovered)),
+      m_params);
+    e->m_dijkstra.reset(new dijkstra_type(make_resumable_dijkstra(m_graph,
+      params)));
+    e->m_dijkstra->init_all(boost::default_dijkstra_visitor());
+    e->m_discovered.clear();
+    m_entries.push_back(e);
+    m_idle.reserve(m_entries.size());
+    return e.get();
+  }
+
+  // Undo the search for the discovered vertices only
+  static void reset(entry& e)
+  {
+    typedef typename dijkstra_type::template param<boost::vertex_color_t>::type
+      color_map_type;
+    typedef typename boost::property_traits<color_map_type>::value_type
+      color_type;
+    typedef boost::color_traits<color_type> color_traits;
+
+    dijkstra_type& d = *e.m_dijkstra;
+    clear(d.get(boost::max_priority_queue_t()));
+
+    typename discovery_list::const_iterator i = e.m_discovered.begin();
+    for (; i != e.m_discovered.end(); ++i) {
+      put(d.get(boost::vertex_color_t()), *i, color_traits::white());
+      put(d.get(boost::vertex_predecessor_t()), *i, *i);
+      put(d.get(boost::vertex_distance_t()), *i,
+        d.get(boost::distance_inf_t()));
+    }
+    e.m_discovered.clear();
+  }
+
+  void release(entry* e)
+  {
+    reset(*e);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_idle.push_back(e);
+  }
+
+  const Graph& m_graph;
+  Params m_params;
+  mutable std::mutex m_mutex; // guards m_entries and m_idle
+  std::vector<boost::shared_ptr<entry> > m_entries;
+  std::vector<entry*> m_idle;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_DIJKSTRA_STATE_POOL_HPP
@@ -0,0 +1,281 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The composed_visitor conforms to the dijkstra visitor concepts and joins
+// any number of visitors into one, like a flat joined_visitor. Callbacks
+// that a visitor inherits unchanged from boost::default_dijkstra_visitor
+// are recognized at compile time and not called at all.
+//
+// control_map<Graph>::type is the ControlMap of the events that any of
+// the visitors handles, for instance to make a dijkstra_object that only
+// halts where the visitors listen.
+//
+// Callbacks that cannot be inspected (non-template, overloaded or of an
+// unrecognized member function type, e.g. volatile) are assumed to be
+// handled.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_COMPOSED_VISITOR_HPP
+#define BLINK_GRAPH_DIJKSTRA_VISITOR_COMPOSED_VISITOR_HPP
+
+#include <blink/graph/dijkstra_control.hpp>
+
+#include <boost/graph/breadth_first_search.hpp> // bfs_visitor
+#include <boost/graph/dijkstra_shortest_paths.hpp> // dijkstra_visitor
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/visitors.hpp> // null_visitor
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <cstddef>
+#include <tuple>
+
+namespace blink {
+
+namespace detail {
+
+// The Boost visitor bases whose callbacks do nothing
+template<typename Class>
+struct is_null_visitor_base : boost::false_type
+{};
+
+template<>
+struct is_null_visitor_base<boost::bfs_visitor<boost::null_visitor> >
+  : boost::true_type
+{};
+
+template<>
+struct is_null_visitor_base<boost::dijkstra_visitor<boost::null_visitor> >
+  : boost::true_type
+{};
+
+// The class of a member function pointer, without type for other types
+template<typename MemberPointer>
+struct member_class
+{};
+
+#define BLINK_COMPOSED_VISITOR_MEMBER_CLASS(qualifiers)                     \
+template<typename R, typename Class, typename... Args>                      \
+struct member_class<R (Class::*)(Args...) qualifiers>                       \
+{                                                                           \
+  typedef Class type;                                                       \
+};
+
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS()
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(const)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(&)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(const &)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(&&)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(const &&)
+#if defined(__cpp_noexcept_function_type)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(noexcept)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(const noexcept)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(& noexcept)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(const & noexcept)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(&& noexcept)
+BLINK_COMPOSED_VISITOR_MEMBER_CLASS(const && noexcept)
+#endif
+
+#undef BLINK_COMPOSED_VISITOR_MEMBER_CLASS
+
+template<typename T>
+struct always_void
+{
+  typedef void type;
+};
+
+// For each event a handles<Visitor, Key, Graph> trait, a call() that
+// forwards to the visitor and the key type (vertex or edge) of the event
+#define BLINK_COMPOSED_VISITOR_EVENT(event, key_type)                       \
+struct event##_event                                                        \
+{                                                                           \
+  template<typename Graph>                                                  \
+  struct key                                                                \
+  {                                                                         \
+    typedef typename boost::graph_traits<Graph>::key_type type;             \
+  };                                                                        \
+                                                                            \
+  template<typename Visitor, typename Key, typename Graph,                  \
+    typename Enable = void>                                                 \
+  struct handles : boost::true_type                                         \
+  {};                                                                       \
+                                                                            \
+  template<typename Visitor, typename Key, typename Graph>                  \
+  struct handles<Visitor, Key, Graph, typename always_void<typename         \
+    member_class<decltype(&Visitor::template event<Key, const Graph>)       \
+    >::type>::type>                                                         \
+    : boost::integral_constant<bool, !is_null_visitor_base<                 \
+        typename member_class<decltype(                                     \
+          &Visitor::template event<Key, const Graph>)>::type>::value>       \
+  {};                                                                       \
+                                                                            \
+  template<typename Visitor, typename Key, typename Graph>                  \
+  static void call(Visitor& visitor, const Key& key, const Graph& graph)    \
+  {                                                                         \
+    visitor.event(key, graph);                                              \
+  }                                                                         \
+};
+
+BLINK_COMPOSED_VISITOR_EVENT(initialize_vertex, vertex_descriptor)
+BLINK_COMPOSED_VISITOR_EVENT(examine_vertex, vertex_descriptor)
+BLINK_COMPOSED_VISITOR_EVENT(examine_edge, edge_descriptor)
+BLINK_COMPOSED_VISITOR_EVENT(discover_vertex, vertex_descriptor)
+BLINK_COMPOSED_VISITOR_EVENT(edge_relaxed, edge_descriptor)
+BLINK_COMPOSED_VISITOR_EVENT(edge_not_relaxed, edge_descriptor)
+BLINK_COMPOSED_VISITOR_EVENT(finish_vertex, vertex_descriptor)
+
+#undef BLINK_COMPOSED_VISITOR_EVENT
+
+template<typename Event, typename Key, typename Graph, typename... Visitors>
+struct any_handles : boost::false_type
+{};
+
+template<typename Event, typename Key, typename Graph, typename Visitor,
+  typename... Visitors>
+struct any_handles<Event, Key, Graph, Visitor, Visitors...>
+  : boost::integral_constant<bool,
+      Event::template handles<Visitor, Key, Graph>::value
+      || any_handles<Event, Key, Graph, Visitors...>::value>
+{};
+
+} // namespace detail
+
+template<typename... Visitors>
+class composed_visitor
+{
+  typedef std::tuple<Visitors...> tuple_type;
+
+  template<typename Event, typename Graph>
+  struct any_handles : detail::any_handles<Event,
+    typename Event::template key<Graph>::type, Graph, Visitors...>::type
+  {};
+
+  template<typename Event, control_point CP, typename Graph>
+  struct mask : boost::integral_constant<unsigned,
+    any_handles<Event, Graph>::value ? 1u << CP : 0u>
+  {};
+
+public:
+  template<typename Graph>
+  struct control_map
+  {
+    typedef control_point_set
+      < mask<detail::initialize_vertex_event, cp_initialize_vertex,
+          Graph>::value
+      | mask<detail::examine_vertex_event, cp_examine_vertex, Graph>::value
+      | mask<detail::examine_edge_event, cp_examine_edge, Graph>::value
+      | mask<detail::discover_vertex_event, cp_discover_vertex, Graph>::value
+      | mask<detail::finish_vertex_event, cp_finish_vertex, Graph>::value
+      | mask<detail::edge_relaxed_event, cp_edge_relaxed, Graph>::value
+      | mask<detail::edge_not_relaxed_event, cp_edge_not_relaxed, Graph>::value
+      > type;
+  };
+
+  // Constructor copies all visitors
+  explicit composed_visitor(const Visitors&... visitors)
+    : m_visitors(visitors...)
+  {}
+
+  template<typename U, typename G>
+  void initialize_vertex(const U& u, const G& g)
+  {
+    dispatch<detail::initialize_vertex_event, 0>(u, g, more<0>());
+  }
+
+  template<typename U, typename G>
+  void examine_vertex(const U& u, const G& g)
+  {
+    dispatch<detail::examine_vertex_event, 0>(u, g, more<0>());
+  }
+
+  template<typename E, typename G>
+  void examine_edge(const E& e, const G& g)
+  {
+    dispatch<detail::examine_edge_event, 0>(e, g, more<0>());
+  }
+
+  template<typename U, typename G>
+  void discover_vertex(const U& u, const G& g)
+  {
+    dispatch<detail::discover_vertex_event, 0>(u, g, more<0>());
+  }
+
+  template<typename E, typename G>
+  void edge_relaxed(const E& e, const G& g)
+  {
+    dispatch<detail::edge_relaxed_event, 0>(e, g, more<0>());
+  }
+
+  template<typename E, typename G>
+  void edge_not_relaxed(const E& e, const G& g)
+  {
+    dispatch<detail::edge_not_relaxed_event, 0>(e, g, more<0>());
+  }
+
+  template<typename U, typename G>
+  void finish_vertex(const U& u, const G& g)
+  {
+    dispatch<detail::finish_vertex_event, 0>(u, g, more<0>());
+  }
+
+  template<std::size_t I>
+  typename std::tuple_element<I, tuple_type>::type& get()
+  {
+    return std::get<I>(m_visitors);
+  }
+
+  template<std::size_t I>
+  const typename std::tuple_element<I, tuple_type>::type& get() const
+  {
+    return std::get<I>(m_visitors);
+  }
+
+private:
+  template<std::size_t I>
+  struct more : boost::integral_constant<bool, (I < sizeof...(Visitors))>
+  {};
+
+  template<typename Event, std::size_t I, typename Key, typename G>
+  void dispatch(const Key& key, const G& g, boost::true_type)
+  {
+    typedef typename std::tuple_element<I, tuple_type>::type visitor_type;
+    call<Event>(std::get<I>(m_visitors), key, g,
+      typename Event::template handles<visitor_type, Key, G>::type());
+    dispatch<Event, I + 1>(key, g, more<I + 1>());
+  }
+
+  template<typename Event, std::size_t I, typename Key, typename G>
+  void dispatch(const Key&, const G&, boost::false_type)
+  {}
+
+  template<typename Event, typename Visitor, typename Key, typename G>
+  static void call(Visitor& visitor, const Key& key, const G& g,
+    boost::true_type)
+  {
+    Event::call(visitor, key, g);
+  }
+
+  template<typename Event, typename Visitor, typename Key, typename G>
+  static void call(Visitor&, const Key&, const G&, boost::false_type)
+  {}
+
+  tuple_type m_visitors;
+};
+
+template<typename... Visitors>
+composed_visitor<Visitors...> compose_visitors(Visitors... visitors)
+{
+  return composed_visitor<Visitors...>(visitors...);
+}
+
+} // namespace blink
+
+#endif //BLINK_GRAPH_DIJKSTRA_VISITOR_COMPOSED_VISITOR_HPP
@@ -0,0 +1,87 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The counting_visitor conforms to the dijkstra visitor concepts and counts
+// the visitor events in a Counters policy (see dijkstra_counters.hpp). The
+// counters are not owned, so that the visitor can be copied freely and
+// share them with a counting_queue.
+//
+//=======================================================================
+//
+#ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_COUNTING_VISITOR_HPP
+#define BLINK_GRAPH_DIJKSTRA_VISITOR_COUNTING_VISITOR_HPP
+
+#include <blink/graph/dijkstra_counters.hpp>
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+
+namespace blink {
+
+template<typename Counters = dijkstra_counters>
+class counting_visitor : public boost::default_dijkstra_visitor
+{
+public:
+  explicit counting_visitor(Counters& counters) : m_counters(&counters)
+  {}
+
+  template<typename U, typename G>
+  void examine_vertex(const U&, const G&)
+  {
+    m_counters->on_examine_vertex();
+  }
+
+  template<typename U, typename G>
+  void discover_vertex(const U&, const G&)
+  {
+    m_counters->on_discover_vertex();
+  }
+
+  template<typename U, typename G>
+  void finish_vertex(const U&, const G&)
+  {
+    m_counters->on_finish_vertex();
+  }
+
+  template<typename E, typename G>
+  void examine_edge(const E&, const G&)
+  {
+    m_counters->on_examine_edge();
+  }
+
+  template<typename E, typename G>
+  void edge_relaxed(const E&, const G&)
+  {
+    m_counters->on_edge_relaxed();
+  }
+
+  template<typename E, typename G>
+  void edge_not_relaxed(const E&, const G&)
+  {
+    m_counters->on_edge_not_relaxed();
+  }
+
+  Counters& counters() const
+  {
+    return *m_counters;
+  }
+
+private:
+  Counters* m_counters;
+};
+
+template<typename Counters>
+counting_visitor<Counters> make_counting_visitor(Counters& counters)
+{
+  return counting_visitor<Counters>(counters);
+}
+
+} // namespace blink
+
+#endif //BLINK_GRAPH_DIJKSTRA_VISITOR_COUNTING_VISITOR_HPP
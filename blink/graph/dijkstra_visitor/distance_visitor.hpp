@@ -17,6 +17,8 @@
 #ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_DISTANCE_VISITOR_HPP
 #define BLINK_GRAPH_DIJKSTRA_VISITOR_DISTANCE_VISITOR_HPP
 
+#include <blink/graph/dijkstra_state.hpp> // dijkstra_state_helper
+
 #include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
 #include <boost/property_map/property_map.hpp>
 #include <boost/smart_ptr.hpp>
@@ -67,12 +69,12 @@ struct distance_visitor_helper
   typedef typename DijkstraState::template param<boost::vertex_distance_t>::type distance_map_type;
   typedef typename DijkstraState::template param<boost::vertex_index_t>::type index_type;
   typedef typename DijkstraState::template param<boost::distance_inf_t>::type distance_value_type;
-  typedef typename distance_visitor<distance_map_type, compare_type> type;
+  typedef distance_visitor<distance_map_type, compare_type> type;
 
   static type make(DijkstraState& state, distance_value_type d)
   {
-    return type(state.get<boost::vertex_distance_t>(), d
-      , state.get<boost::distance_compare_t>());
+    return type(state.template get<boost::vertex_distance_t>(), d
+      , state.template get<boost::distance_compare_t>());
   }
 };
 
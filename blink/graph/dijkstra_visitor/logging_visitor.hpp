@@ -17,6 +17,7 @@
 #ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_LOGGING_VISITOR_HPP
 #define BLINK_GRAPH_DIJKSTRA_VISITOR_LOGGING_VISITOR_HPP
 #include <boost/ref.hpp>
+#include <ostream> // endl
 namespace blink {
 template<typename OutStream>
 struct logging_visitor
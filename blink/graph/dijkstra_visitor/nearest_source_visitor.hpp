@@ -18,6 +18,7 @@
 #ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_NEAREST_SOURCE_VISITOR_HPP
 #define BLINK_GRAPH_DIJKSTRA_VISITOR_NEAREST_SOURCE_VISITOR_HPP
 
+#include <blink/graph/dijkstra_state.hpp> // dijkstra_state_helper
 #include <blink/graph/property_maps/vertex_property_map_helper.hpp>
 #include <boost/tuple/tuple.hpp> //tie
 #include <boost/graph/dijkstra_shortest_paths.hpp>
@@ -54,8 +55,8 @@ struct nearest_source_visitor : public boost::default_dijkstra_visitor
 template<typename Graph, typename NearestsourceMap>
 void init_nearest_source_map(const Graph& g, NearestsourceMap nearest)
 {
-  typename graph_traits<Graph>::vertex_iterator ui, ui_end;
-  for (tie(ui, ui_end) = vertices(g); ui != ui_end; ++ui) {
+  typename boost::graph_traits<Graph>::vertex_iterator ui, ui_end;
+  for (boost::tie(ui, ui_end) = vertices(g); ui != ui_end; ++ui) {
     put(nearest, *ui, *ui);
   }
 }
@@ -67,13 +68,13 @@ struct nearest_source_helper
   typedef typename DijkstraState::graph_type graph_type;
 
   typedef typename boost::graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
-  typedef typename vertex_property_map_helper<vertex_descriptor,graph_type, index_type> helper; 
+  typedef vertex_property_map_helper<vertex_descriptor,graph_type, index_type> helper; 
   typedef typename helper::type map_type;
-  typedef typename nearest_source_visitor<map_type> visitor_type;
+  typedef nearest_source_visitor<map_type> visitor_type;
  
   static map_type make_map(DijkstraState& state)
   {
-    return helper::make(state.get_graph(), state.get<boost::vertex_index_t>());
+    return helper::make(state.get_graph(), state.template get<boost::vertex_index_t>());
   }
 
     static visitor_type make_visitor(DijkstraState& state)
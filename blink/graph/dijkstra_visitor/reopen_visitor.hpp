@@ -0,0 +1,75 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The reopen visitor is used to repair a search after edge weights
+// decreased. When an edge is examined whose black target can be reached
+// shorter, the target is made gray and queued again, so that the search
+// relaxes it as a gray target. It relies on examine_edge being called
+// before the color of the target is read.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_REOPEN_VISITOR_HPP
+#define BLINK_GRAPH_DIJKSTRA_VISITOR_REOPEN_VISITOR_HPP
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/properties.hpp> // color_traits
+#include <boost/property_map/property_map.hpp>
+
+namespace blink {
+
+template<typename Queue, typename WeightMap, typename DistanceMap,
+  typename ColorMap, typename Combine, typename Compare>
+class reopen_visitor : public boost::default_dijkstra_visitor
+{
+  typedef typename boost::property_traits<ColorMap>::value_type color_type;
+  typedef boost::color_traits<color_type> color_traits;
+
+public:
+  reopen_visitor(Queue& queue, WeightMap weight, DistanceMap distance,
+    ColorMap color, Combine combine, Compare compare)
+    : m_queue(&queue), m_weight(weight), m_distance(distance), m_color(color)
+    , m_combine(combine), m_compare(compare)
+  {}
+
+  template<typename E, typename G>
+  void examine_edge(const E& e, const G& g)
+  {
+    if (get(m_color, target(e, g)) == color_traits::black()
+      && m_compare(m_combine(get(m_distance, source(e, g)), get(m_weight, e)),
+        get(m_distance, target(e, g)))) {
+      put(m_color, target(e, g), color_traits::gray());
+      m_queue->push(target(e, g));
+    }
+  }
+
+private:
+  Queue* m_queue;
+  WeightMap m_weight;
+  DistanceMap m_distance;
+  ColorMap m_color;
+  Combine m_combine;
+  Compare m_compare;
+};
+
+template<typename Queue, typename WeightMap, typename DistanceMap,
+  typename ColorMap, typename Combine, typename Compare>
+reopen_visitor<Queue, WeightMap, DistanceMap, ColorMap, Combine, Compare>
+  make_reopen_visitor(Queue& queue, WeightMap weight, DistanceMap distance,
+    ColorMap color, Combine combine, Compare compare)
+{
+  return reopen_visitor<Queue, WeightMap, DistanceMap, ColorMap, Combine,
+    Compare>(queue, weight, distance, color, combine, compare);
+}
+
+} // namespace blink
+
+#endif //BLINK_GRAPH_DIJKSTRA_VISITOR_REOPEN_VISITOR_HPP
@@ -0,0 +1,135 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// statistics_visitor implements the dijkstra visitor and interruptor
+// concepts. It counts the work done by the search in an expand_statistics
+// and returns true on do_interrupt() once a budget of settled vertices or
+// scanned edges is used. Edges are only checked between vertices, so the
+// edge budget can be exceeded by the out-degree of the last vertex.
+//
+//=======================================================================
+//
+#ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_STATISTICS_VISITOR_HPP
+#define BLINK_GRAPH_DIJKSTRA_VISITOR_STATISTICS_VISITOR_HPP
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/property_map/property_map.hpp>
+#include <boost/smart_ptr.hpp>
+
+#include <cstddef>
+
+namespace blink {
+
+template<typename Distance>
+struct expand_statistics
+{
+  expand_statistics(Distance zero = Distance())
+    : vertices_settled(0), vertices_discovered(0), edges_scanned(0)
+    , relaxations(0), decrease_keys(0), max_queue_size(0), radius(zero)
+    , completed(false)
+  {}
+
+  std::size_t vertices_settled;
+  std::size_t vertices_discovered;
+  std::size_t edges_scanned;
+  std::size_t relaxations; // including decrease_keys
+  std::size_t decrease_keys;
+  std::size_t max_queue_size;
+  Distance radius; // distance of the last settled vertex
+  bool completed; // the queue is empty
+};
+
+template<typename Queue, typename DistanceMap>
+class statistics_visitor : public boost::default_dijkstra_visitor
+{
+  typedef typename boost::property_traits<DistanceMap>::value_type distance_type;
+
+public:
+  typedef expand_statistics<distance_type> statistics_type;
+
+  statistics_visitor(const Queue& queue, DistanceMap distance_map,
+    distance_type zero,
+    std::size_t max_settled_vertices = std::size_t(-1),
+    std::size_t max_scanned_edges = std::size_t(-1))
+    : m_queue(&queue), m_distance_map(distance_map)
+    , m_max_settled_vertices(max_settled_vertices)
+    , m_max_scanned_edges(max_scanned_edges)
+  {
+    m_statistics.reset(new statistics_type(zero) );
+    m_statistics->max_queue_size = queue.size();
+  }
+
+  template<typename U, typename G>
+  void discover_vertex(const U&, const G&)
+  {
+    ++m_statistics->vertices_discovered;
+
+    // called before u is pushed
+    if (m_queue->size() + 1 > m_statistics->max_queue_size) {
+      m_statistics->max_queue_size = m_queue->size() + 1;
+    }
+  }
+
+  template<typename E, typename G>
+  void examine_edge(const E&, const G&)
+  {
+    ++m_statistics->edges_scanned;
+  }
+
+  // a tree edge is relaxed before its target is discovered, so every
+  // relaxation that is not followed by a discovery is a decrease-key.
+  template<typename E, typename G>
+  void edge_relaxed(const E&, const G&)
+  {
+    ++m_statistics->relaxations;
+  }
+
+  template<typename U, typename G>
+  void finish_vertex(const U& u, const G&)
+  {
+    ++m_statistics->vertices_settled;
+    m_statistics->radius = get(m_distance_map, u);
+  }
+
+  inline bool do_interrupt() const
+  {
+    return m_statistics->vertices_settled >= m_max_settled_vertices
+      || m_statistics->edges_scanned >= m_max_scanned_edges;
+  }
+
+  statistics_type statistics() const
+  {
+    statistics_type s = *m_statistics;
+    s.decrease_keys = s.relaxations - s.vertices_discovered;
+    s.completed = m_queue->empty();
+    return s;
+  }
+
+private:
+  boost::shared_ptr<statistics_type> m_statistics;
+  const Queue* m_queue;
+  DistanceMap m_distance_map;
+  std::size_t m_max_settled_vertices;
+  std::size_t m_max_scanned_edges;
+};
+
+template<typename Queue, typename DistanceMap, typename Distance>
+statistics_visitor<Queue, DistanceMap> make_statistics_visitor(
+  const Queue& queue, DistanceMap distance_map, Distance zero,
+  std::size_t max_settled_vertices = std::size_t(-1),
+  std::size_t max_scanned_edges = std::size_t(-1))
+{
+  return statistics_visitor<Queue, DistanceMap>(queue, distance_map, zero,
+    max_settled_vertices, max_scanned_edges);
+}
+
+} // namespace blink
+
+#endif //BLINK_GRAPH_DIJKSTRA_VISITOR_STATISTICS_VISITOR_HPP
@@ -18,6 +18,9 @@
 #ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_TARGET_VISITOR_HPP
 #define BLINK_GRAPH_DIJKSTRA_VISITOR_TARGET_VISITOR_HPP
 
+#include <blink/graph/dijkstra_state.hpp> // dijkstra_state_helper
+#include <blink/graph/property_maps/vertex_property_map_helper.hpp>
+
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/property_map/property_map.hpp>
 #include <boost/graph/properties.hpp>
@@ -88,8 +91,8 @@ public:
   template<typename TargetRange>
   void add_targets(const TargetRange& r) 
   {
-    boost::range_iterator<const TargetRange>::type i = boost::begin(r);
-    boost::range_iterator<const TargetRange>::type end = boost::end(r);
+    typename boost::range_iterator<const TargetRange>::type i = boost::begin(r);
+    typename boost::range_iterator<const TargetRange>::type end = boost::end(r);
     for(; i != end; ++i) {
       add_target(*i);
     }
@@ -109,13 +112,13 @@ struct target_helper
   typedef typename DijkstraState::graph_type graph_type;
 
   typedef typename boost::graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
-  typedef typename vertex_property_map_helper<boost::default_color_type, graph_type, index_type> helper; 
+  typedef vertex_property_map_helper<boost::default_color_type, graph_type, index_type> helper; 
   typedef typename helper::type map_type;
-  typedef typename target_visitor<graph_type, map_type> visitor_type;
+  typedef target_visitor<graph_type, map_type> visitor_type;
 
   static map_type make_map(DijkstraState& state)
   {
-    return helper::make(state.get_graph(), state.get<boost::vertex_index_t>());
+    return helper::make(state.get_graph(), state.template get<boost::vertex_index_t>());
   }
   
   static visitor_type make_visitor(DijkstraState& state)
@@ -134,7 +137,7 @@ struct target_helper_indirect : target_helper<typename dijkstra_state_helper<Gra
 {};
 
 template<typename DijkstraState>
-typename typename target_helper<DijkstraState>::visitor_type
+typename target_helper<DijkstraState>::visitor_type
 make_target_visitor(DijkstraState& state)
 {
   return target_helper<DijkstraState>::make_visitor(state);
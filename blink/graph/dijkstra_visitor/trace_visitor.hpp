@@ -0,0 +1,251 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The trace_visitor conforms to the dijkstra visitor concepts and records
+// the same events as the logging_visitor, as fixed-width binary records in
+// a trace_buffer. The buffer does not own its memory, it can be a vector
+// or a memory-mapped file. When it is full further events are counted as
+// dropped, the search is not slowed down.
+//
+// Reading the clock costs more than writing a record, so the clock is only
+// read at examine_vertex and finish_vertex. The other events get the time
+// of the preceding one of those.
+//
+// write_trace() saves a buffer as a trace file, that tools/trace_decoder
+// renders as logging_visitor text or as Chrome trace (Perfetto) JSON.
+// Trace files use the byte order of the machine that wrote them.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_DIJKSTRA_VISITOR_TRACE_VISITOR_HPP
+#define BLINK_GRAPH_DIJKSTRA_VISITOR_TRACE_VISITOR_HPP
+
+#include <blink/graph/dijkstra_control.hpp> // control_point
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/property_map/property_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+namespace blink {
+
+struct trace_record
+{
+  std::uint64_t time;        // nanoseconds since the buffer was started
+  std::uint32_t cp;          // control_point
+  std::uint32_t reserved;
+  std::uint64_t u;           // vertex index, or source index for edges
+  std::uint64_t v;           // vertex index, or target index for edges
+};
+
+struct trace_file_header
+{
+  char magic[8];             // "BLKTRACE"
+  std::uint32_t version;
+  std::uint32_t record_size;
+  std::uint64_t count;
+  std::uint64_t dropped;
+};
+
+// Copies share the position in the memory
+class trace_buffer
+{
+public:
+  typedef std::chrono::steady_clock clock_type;
+
+  trace_buffer(trace_record* first, trace_record* last)
+    : m_state(new state(first, last))
+  {}
+
+  // Forget the records and restart the clock
+  void restart()
+  {
+    m_state->m_end = m_state->m_first;
+    m_state->m_dropped = 0;
+    m_state->m_time = 0;
+    m_state->m_start = clock_type::now();
+  }
+
+  // Read the clock for the following records
+  inline void tick()
+  {
+    m_state->m_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock_type::now() - m_state->m_start).count();
+  }
+
+  inline void record(control_point cp, std::uint64_t u, std::uint64_t v)
+  {
+    state& s = *m_state;
+    if (s.m_end == s.m_last) {
+      ++s.m_dropped;
+      return;
+    }
+    s.m_end->time = s.m_time;
+    s.m_end->cp = cp;
+    s.m_end->reserved = 0;
+    s.m_end->u = u;
+    s.m_end->v = v;
+    ++s.m_end;
+  }
+
+  const trace_record* begin() const
+  {
+    return m_state->m_first;
+  }
+
+  const trace_record* end() const
+  {
+    return m_state->m_end;
+  }
+
+  std::size_t size() const
+  {
+    return m_state->m_end - m_state->m_first;
+  }
+
+  std::size_t capacity() const
+  {
+    return m_state->m_last - m_state->m_first;
+  }
+
+  // The events that did not fit
+  std::size_t dropped() const
+  {
+    return m_state->m_dropped;
+  }
+
+private:
+  struct state
+  {
+    state(trace_record* first, trace_record* last)
+      : m_first(first), m_end(first), m_last(last), m_dropped(0)
+      , m_time(0), m_start(clock_type::now())
+    {}
+
+    trace_record* m_first;
+    trace_record* m_end;
+    trace_record* m_last;
+    std::size_t m_dropped;
+    std::uint64_t m_time;
+    clock_type::time_point m_start;
+  };
+
+  boost::shared_ptr<state> m_state;
+};
+
+inline trace_file_header make_trace_file_header(std::uint64_t count,
+  std::uint64_t dropped)
+{
+  trace_file_header header;
+  std::memcpy(header.magic, "BLKTRACE", 8);
+  header.version = 1;
+  header.record_size = sizeof(trace_record);
+  header.count = count;
+  header.dropped = dropped;
+  return header;
+}
+
+// Write the buffer as a trace file, the stream must be binary
+inline std::ostream& write_trace(std::ostream& os, const trace_buffer& buffer)
+{
+  const trace_file_header header = make_trace_file_header(buffer.size(),
+    buffer.dropped());
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(buffer.begin()),
+    buffer.size() * sizeof(trace_record));
+  return os;
+}
+
+template<typename IndexMap>
+class trace_visitor : public boost::default_dijkstra_visitor
+{
+public:
+  trace_visitor(const trace_buffer& buffer, IndexMap index)
+    : m_buffer(buffer), m_index(index)
+  {}
+
+  template<typename U, typename G>
+  void initialize_vertex(const U& u, const G&)
+  {
+    record(cp_initialize_vertex, u);
+  }
+
+  template<typename U, typename G>
+  void examine_vertex(const U& u, const G&)
+  {
+    m_buffer.tick();
+    record(cp_examine_vertex, u);
+  }
+
+  template<typename E, typename G>
+  void examine_edge(const E& e, const G& g)
+  {
+    record(cp_examine_edge, source(e, g), target(e, g));
+  }
+
+  template<typename U, typename G>
+  void discover_vertex(const U& u, const G&)
+  {
+    record(cp_discover_vertex, u);
+  }
+
+  template<typename E, typename G>
+  void edge_relaxed(const E& e, const G& g)
+  {
+    record(cp_edge_relaxed, source(e, g), target(e, g));
+  }
+
+  template<typename E, typename G>
+  void edge_not_relaxed(const E& e, const G& g)
+  {
+    record(cp_edge_not_relaxed, source(e, g), target(e, g));
+  }
+
+  template<typename U, typename G>
+  void finish_vertex(const U& u, const G&)
+  {
+    m_buffer.tick();
+    record(cp_finish_vertex, u);
+  }
+
+private:
+  template<typename U>
+  void record(control_point cp, const U& u)
+  {
+    const std::uint64_t i = get(m_index, u);
+    m_buffer.record(cp, i, i);
+  }
+
+  template<typename U>
+  void record(control_point cp, const U& u, const U& v)
+  {
+    m_buffer.record(cp, get(m_index, u), get(m_index, v));
+  }
+
+  trace_buffer m_buffer;
+  IndexMap m_index;
+};
+
+template<typename IndexMap>
+trace_visitor<IndexMap> make_trace_visitor(const trace_buffer& buffer,
+  IndexMap index)
+{
+  return trace_visitor<IndexMap>(buffer, index);
+}
+
+} // namespace blink
+
+#endif //BLINK_GRAPH_DIJKSTRA_VISITOR_TRACE_VISITOR_HPP
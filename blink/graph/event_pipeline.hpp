@@ -0,0 +1,259 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// event_pipeline runs heavy dijkstra visitors on their own threads. The
+// visitor() of the pipeline is passed to expand() on the search thread,
+// it publishes the finish_vertex and edge_relaxed events into one
+// spsc_ring_buffer per consumer. Every consumer thread replays all events
+// on its own visitor, which only needs the usual finish_vertex and
+// edge_relaxed callbacks.
+//
+// The search never blocks on a full buffer. Events that do not fit are
+// kept aside and visitor() doubles as interruptor: do_interrupt() returns
+// true until they are published, so that a resumable search pauses and
+// can be expanded again later.
+//
+// Consumers run behind the search, they should only read the distance and
+// predecessor of settled vertices, and only from maps whose elements are
+// not moved by writes (e.g. vector property maps).
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_EVENT_PIPELINE_HPP
+#define BLINK_GRAPH_EVENT_PIPELINE_HPP
+
+#include <blink/graph/dijkstra_control.hpp> // dijkstra_event
+#include <blink/graph/spsc_ring_buffer.hpp>
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/graph_traits.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace blink {
+
+template<typename Graph, typename Visitor>
+class event_pipeline;
+
+// The search side of an event_pipeline, a dijkstra visitor and interruptor
+template<typename Graph, typename Visitor>
+class pipeline_visitor : public boost::default_dijkstra_visitor
+{
+public:
+  explicit pipeline_visitor(event_pipeline<Graph, Visitor>& pipeline)
+    : m_pipeline(&pipeline)
+  {}
+
+  template<typename E, typename G>
+  void edge_relaxed(const E& e, const G& g)
+  {
+    m_pipeline->publish(cp_edge_relaxed, source(e, g), target(e, g), e);
+  }
+
+  template<typename U, typename G>
+  void finish_vertex(const U& u, const G&)
+  {
+    m_pipeline->publish(cp_finish_vertex, u, u,
+      typename boost::graph_traits<Graph>::edge_descriptor());
+  }
+
+  inline bool do_interrupt()
+  {
+    return !m_pipeline->flush();
+  }
+
+private:
+  event_pipeline<Graph, Visitor>* m_pipeline;
+};
+
+template<typename Graph, typename Visitor>
+class event_pipeline : boost::noncopyable
+{
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor
+    vertex_descriptor;
+  typedef typename boost::graph_traits<Graph>::edge_descriptor
+    edge_descriptor;
+
+public:
+  typedef dijkstra_event<vertex_descriptor, edge_descriptor> event_type;
+  typedef pipeline_visitor<Graph, Visitor> visitor_type;
+
+  // Starts one thread per consumer, each with a buffer of (at least)
+  // capacity events
+  event_pipeline(const Graph& graph, const std::vector<Visitor>& consumers,
+    std::size_t capacity = 4096)
+    : m_graph(graph), m_closed(false)
+  {
+    for (std::size_t i = 0; i < consumers.size(); ++i) {
+      m_consumers.push_back(boost::shared_ptr<consumer>(
+        new consumer(consumers[i], capacity)));
+    }
+    for (std::size_t i = 0; i < m_consumers.size(); ++i) {
+      m_threads.push_back(std::thread(&event_pipeline::consume, this,
+        m_consumers[i].get()));
+    }
+  }
+
+  ~event_pipeline()
+  {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  visitor_type visitor()
+  {
+    return visitor_type(*this);
+  }
+
+  // Publishes the events that were kept aside, returns true when all
+  // events are published. Search thread only.
+  bool flush()
+  {
+    bool done = true;
+    for (std::size_t i = 0; i < m_consumers.size(); ++i) {
+      consumer& c = *m_consumers[i];
+      while (!c.m_pending.empty()
+        && c.m_buffer.try_push(c.m_pending.front())) {
+        c.m_pending.pop_front();
+      }
+      done = done && c.m_pending.empty();
+    }
+    return done;
+  }
+
+  // Waits until the consumers have handled all events and stops them.
+  // Rethrows the first exception thrown by a consumer.
+  void close()
+  {
+    if (m_closed) {
+      return;
+    }
+    while (!flush()) {
+      std::this_thread::yield();
+    }
+    m_closed = true;
+    for (std::size_t i = 0; i < m_consumers.size(); ++i) {
+      m_consumers[i]->m_closed.store(true, std::memory_order_release);
+    }
+    for (std::size_t i = 0; i < m_threads.size(); ++i) {
+      m_threads[i].join();
+    }
+    for (std::size_t i = 0; i < m_consumers.size(); ++i) {
+      if (m_consumers[i]->m_exception) {
+        std::rethrow_exception(m_consumers[i]->m_exception);
+      }
+    }
+  }
+
+  std::size_t size() const
+  {
+    return m_consumers.size();
+  }
+
+  // The visitor of the i-th consumer, only to be read after close()
+  const Visitor& consumer_visitor(std::size_t i) const
+  {
+    return m_consumers[i]->m_visitor;
+  }
+
+private:
+  friend class pipeline_visitor<Graph, Visitor>;
+
+  struct consumer
+  {
+    consumer(const Visitor& visitor, std::size_t capacity)
+      : m_visitor(visitor), m_buffer(capacity), m_closed(false)
+    {}
+
+    Visitor m_visitor;
+    spsc_ring_buffer<event_type> m_buffer;
+    std::deque<event_type> m_pending; // search thread only
+    std::atomic<bool> m_closed;
+    std::exception_ptr m_exception;
+  };
+
+  void publish(control_point cp, vertex_descriptor u, vertex_descriptor v,
+    edge_descriptor e)
+  {
+    const event_type event = { cp, u, v, e };
+    for (std::size_t i = 0; i < m_consumers.size(); ++i) {
+      consumer& c = *m_consumers[i];
+      if (!c.m_pending.empty() || !c.m_buffer.try_push(event)) {
+        c.m_pending.push_back(event);
+      }
+    }
+  }
+
+  void consume(consumer* c)
+  {
+    event_type event;
+    std::size_t idle = 0;
+    for (;;) {
+      if (c->m_buffer.try_pop(event)) {
+        idle = 0;
+        if (!c->m_exception) {
+          try {
+            dispatch(c->m_visitor, event);
+          } catch (...) {
+            // keep draining, so that the search is not paused forever
+            c->m_exception = std::current_exception();
+          }
+        }
+      } else if (c->m_closed.load(std::memory_order_acquire)) {
+        if (c->m_buffer.empty()) {
+          return;
+        }
+      } else {
+        backoff(++idle);
+      }
+    }
+  }
+
+  void dispatch(Visitor& visitor, const event_type& event)
+  {
+    if (event.cp == cp_finish_vertex) {
+      visitor.finish_vertex(event.u, m_graph);
+    } else {
+      visitor.edge_relaxed(event.e, m_graph);
+    }
+  }
+
+  // Spin first, then yield, then sleep while the search is not producing
+  static void backoff(std::size_t idle)
+  {
+    if (idle < 64) {
+      return;
+    } else if (idle < 1024) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+
+  const Graph& m_graph;
+  std::vector<boost::shared_ptr<consumer> > m_consumers;
+  std::vector<std::thread> m_threads;
+  bool m_closed;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_EVENT_PIPELINE_HPP
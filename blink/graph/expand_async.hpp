@@ -0,0 +1,225 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// expand_async expands a resumable search on an executor, in time slices.
+// Each slice is a task posted to the executor, so that a long search does
+// not hold a thread of the executor (or an event loop posting to it). An
+// executor is anything with a post(task) member, such as thread_pool or
+// inline_executor.
+//
+// The search ends when its queue is empty, its interruptor returns true,
+// an exception is thrown or it is cancelled. Cancellation is checked
+// between slices. On completion done(completed, exception) is called on
+// the executor, completed is true if the queue is empty.
+//
+// expand_async_future returns a std::future instead.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_EXPAND_ASYNC_HPP
+#define BLINK_GRAPH_EXPAND_ASYNC_HPP
+
+#include <blink/graph/breadth_first_search.hpp> // either_interruptor
+#include <blink/graph/deadline_interruptor.hpp>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+
+namespace blink {
+
+// Runs posted tasks on the calling thread. A task posted from a running
+// task is run after it returns, so that slices do not recurse. Not thread
+// safe.
+class inline_executor : boost::noncopyable
+{
+public:
+  typedef std::function<void()> task_type;
+
+  inline_executor() : m_running(false)
+  {}
+
+  template<typename Task>
+  void post(Task task)
+  {
+    m_tasks.push_back(task_type(task));
+    if (m_running) {
+      return;
+    }
+    m_running = true;
+    try {
+      while (!m_tasks.empty()) {
+        task_type next;
+        next.swap(m_tasks.front());
+        m_tasks.pop_front();
+        next();
+      }
+    } catch (...) {
+      m_running = false;
+      throw;
+    }
+    m_running = false;
+  }
+
+private:
+  std::deque<task_type> m_tasks;
+  bool m_running;
+};
+
+// Copies share their state, cancel() can be called from any thread
+class cancellation_flag
+{
+public:
+  cancellation_flag() : m_cancelled(new std::atomic<bool>(false))
+  {}
+
+  void cancel()
+  {
+    m_cancelled->store(true);
+  }
+
+  bool cancelled() const
+  {
+    return m_cancelled->load();
+  }
+
+private:
+  boost::shared_ptr<std::atomic<bool> > m_cancelled;
+};
+
+namespace detail {
+
+template<typename Dijkstra, typename Interruptor, typename Visitor,
+  typename Executor, typename Done>
+class async_expansion
+{
+public:
+  async_expansion(const Dijkstra& dijkstra, Interruptor interruptor,
+    Visitor visitor, Executor& executor, Done done, cancellation_flag cancel,
+    deadline_interruptor::duration slice)
+    : m_dijkstra(dijkstra), m_interruptor(interruptor), m_visitor(visitor)
+    , m_executor(executor), m_done(done), m_cancel(cancel), m_deadline(slice)
+  {}
+
+  struct slice_task
+  {
+    void operator()()
+    {
+      m_expansion->run_slice(m_expansion);
+    }
+
+    boost::shared_ptr<async_expansion> m_expansion;
+  };
+
+  static void post(const boost::shared_ptr<async_expansion>& expansion)
+  {
+    slice_task task = { expansion };
+    expansion->m_executor.post(task);
+  }
+
+private:
+  void run_slice(const boost::shared_ptr<async_expansion>& self)
+  {
+    if (m_cancel.cancelled()) {
+      m_done(false, std::exception_ptr());
+      return;
+    }
+
+    // The deadline is asked first, so the interruptor of the caller is
+    // not asked when the slice ends. Both are used by reference to keep
+    // their state over slices.
+    bool completed = false;
+    try {
+      m_deadline.restart();
+      either_interruptor<deadline_interruptor&, Interruptor&>
+        interruptor(m_deadline, m_interruptor);
+      completed = m_dijkstra.template expand<either_interruptor<
+        deadline_interruptor&, Interruptor&>, Visitor&>(interruptor,
+        m_visitor);
+    } catch (...) {
+      m_done(false, std::current_exception());
+      return;
+    }
+
+    if (!completed && m_deadline.expired() && !m_cancel.cancelled()) {
+      post(self);
+    } else {
+      m_done(completed, std::exception_ptr());
+    }
+  }
+
+  Dijkstra m_dijkstra;
+  Interruptor m_interruptor;
+  Visitor m_visitor;
+  Executor& m_executor;
+  Done m_done;
+  cancellation_flag m_cancel;
+  deadline_interruptor m_deadline;
+};
+
+template<typename T>
+struct promise_done
+{
+  void operator()(T value, std::exception_ptr exception)
+  {
+    if (exception) {
+      m_promise->set_exception(exception);
+    } else {
+      m_promise->set_value(value);
+    }
+  }
+
+  boost::shared_ptr<std::promise<T> > m_promise;
+};
+
+} // namespace detail
+
+// Start expanding the initialized search on the executor and return. The
+// dijkstra (or its copies, which share its state) must not be used until
+// done is called, and the executor must outlive the search.
+template<typename Dijkstra, typename Interruptor, typename Visitor,
+  typename Executor, typename Done>
+void expand_async(const Dijkstra& dijkstra, Interruptor interruptor,
+  Visitor visitor, Executor& executor, Done done,
+  cancellation_flag cancel = cancellation_flag(),
+  deadline_interruptor::duration slice = std::chrono::milliseconds(1))
+{
+  typedef detail::async_expansion<Dijkstra, Interruptor, Visitor, Executor,
+    Done> expansion_type;
+  expansion_type::post(boost::shared_ptr<expansion_type>(new expansion_type(
+    dijkstra, interruptor, visitor, executor, done, cancel, slice)));
+}
+
+// As above, the future is true if the queue is empty, false if the search
+// was interrupted or cancelled.
+template<typename Dijkstra, typename Interruptor, typename Visitor,
+  typename Executor>
+std::future<bool> expand_async_future(const Dijkstra& dijkstra, 
+  Interruptor interruptor, Visitor visitor, Executor& executor,
+  cancellation_flag cancel = cancellation_flag(),
+  deadline_interruptor::duration slice = std::chrono::milliseconds(1))
+{
+  detail::promise_done<bool> done = {
+    boost::shared_ptr<std::promise<bool> >(new std::promise<bool>) };
+  std::future<bool> future = done.m_promise->get_future();
+  expand_async(dijkstra, interruptor, visitor, executor, done, cancel, slice);
+  return future;
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_EXPAND_ASYNC_HPP
@@ -0,0 +1,75 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// expand_for expands a resumable_dijkstra with a budget of settled vertices
+// and scanned edges, and reports the work done in an expand_statistics, 
+// see statistics_visitor.hpp.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_EXPAND_FOR_HPP
+#define BLINK_GRAPH_EXPAND_FOR_HPP
+
+#include <blink/graph/dijkstra_visitor/joined_visitor.hpp>
+#include <blink/graph/dijkstra_visitor/statistics_visitor.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/named_function_params.hpp>
+
+#include <cstddef>
+
+namespace blink {
+
+// The statistics_visitor and expand_statistics types of a search
+template<typename DijkstraState>
+struct expand_for_helper
+{
+  typedef statistics_visitor
+    < typename DijkstraState::template param<boost::max_priority_queue_t>::type
+    , typename DijkstraState::template param<boost::vertex_distance_t>::type
+    > statistics_visitor_type;
+  typedef typename statistics_visitor_type::statistics_type type;
+};
+
+// Expand the shortest path search until max_settled_vertices are settled
+// or max_scanned_edges are scanned, and report the work done. 
+template<typename DijkstraState, typename SecondVisitor>
+typename expand_for_helper<DijkstraState>::type expand_for(
+  resumable_dijkstra<DijkstraState>& dijkstra, 
+  std::size_t max_settled_vertices, std::size_t max_scanned_edges, 
+  SecondVisitor visitor)
+{
+  typedef typename expand_for_helper<DijkstraState>::statistics_visitor_type
+    statistics_visitor_type;
+  statistics_visitor_type statistics(
+    dijkstra.get(boost::max_priority_queue_t()), 
+    dijkstra.get(boost::vertex_distance_t()), 
+    dijkstra.get(boost::distance_zero_t()), max_settled_vertices, 
+    max_scanned_edges);
+
+  dijkstra.expand(statistics, make_joined_visitor(statistics, visitor));
+  return statistics.statistics();
+}
+
+template<typename DijkstraState>
+typename expand_for_helper<DijkstraState>::type expand_for(
+  resumable_dijkstra<DijkstraState>& dijkstra, 
+  std::size_t max_settled_vertices, 
+  std::size_t max_scanned_edges = std::size_t(-1))
+{
+  return expand_for(dijkstra, max_settled_vertices, max_scanned_edges, 
+    boost::default_dijkstra_visitor());
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_EXPAND_FOR_HPP
@@ -0,0 +1,549 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Loading large graphs into a flat (compressed sparse row) graph, without
+// building an adjacency_list edge by edge.
+//
+// flat_graph<Weight>::type is a directed compressed_sparse_row_graph with
+// an edge_weight property, it can be passed to make_resumable_dijkstra as
+// is. The loaders fill a flat_edge_list, make_flat_graph turns it into the
+// graph in two passes over the arcs: counting the out-degrees and placing
+// the arcs.
+//
+//   read_dimacs_graph        DIMACS 9th challenge .gr file ("a u v w")
+//   read_dimacs_coordinates  DIMACS 9th challenge .co file ("v id x y")
+//   read_edge_list           binary edge list, see write_edge_list
+//
+// The text files are read in chunks of whole lines (64 MB) and each chunk
+// is parsed by num_threads threads, each on a block of lines: first every
+// thread counts its arcs, then every thread parses its arcs into place.
+// Reading takes one chunk besides the edge list, rather than the whole
+// file, which is larger than the edge list itself. DIMACS vertex ids
+// start at 1, they are stored from 0.
+//
+// The binary edge list is a header ("BLKEDGES", version, sizeof weight,
+// num_vertices, num_arcs), followed by the sources, the targets and the
+// weights as arrays. It uses the byte order of the machine that wrote it.
+//
+// All loaders throw std::runtime_error on files they cannot read.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_FLAT_GRAPH_HPP
+#define BLINK_GRAPH_FLAT_GRAPH_HPP
+
+#include <blink/graph/parallel_for_blocks.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstring> // memcmp, memcpy
+#include <fstream>
+#include <functional> // bind
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace blink {
+
+template<typename Weight = double, typename Vertex = boost::uint32_t>
+struct flat_graph
+{
+  typedef boost::compressed_sparse_row_graph<boost::directedS,
+    boost::no_property, boost::property<boost::edge_weight_t, Weight>,
+    boost::no_property, Vertex, std::size_t> type;
+};
+
+template<typename Weight = double, typename Vertex = boost::uint32_t>
+struct flat_edge_list
+{
+  typedef Weight weight_type;
+  typedef Vertex vertex_type;
+
+  flat_edge_list() : num_vertices(0)
+  {}
+
+  std::size_t num_vertices;
+  std::vector<Vertex> sources;
+  std::vector<Vertex> targets;
+  std::vector<Weight> weights;
+};
+
+struct flat_coordinate
+{
+  long x;
+  long y;
+};
+
+namespace detail {
+
+  template<typename Vertex>
+  struct flat_edge_at
+  {
+    typedef std::pair<Vertex, Vertex> result_type;
+
+    flat_edge_at(const Vertex* sources, const Vertex* targets)
+      : m_sources(sources), m_targets(targets)
+    {}
+
+    result_type operator()(std::size_t i) const
+    {
+      return result_type(m_sources[i], m_targets[i]);
+    }
+
+    const Vertex* m_sources;
+    const Vertex* m_targets;
+  };
+
+  // Reads a text file in chunks of whole lines, so that a large file is
+  // not held in memory at once. The last line of the file is terminated.
+  class line_chunk_reader
+  {
+  public:
+    explicit line_chunk_reader(const std::string& path,
+      std::size_t chunk_size = std::size_t(1) << 26)
+      : m_is(path.c_str(), std::ios::binary), m_path(path)
+      , m_chunk_size(chunk_size), m_begin(0), m_end(0), m_eof(false)
+    {
+      if (!m_is) {
+        boost::throw_exception(std::runtime_error("cannot open " + path));
+      }
+      m_is.seekg(0, std::ios::end);
+      m_file_size = static_cast<std::size_t>(m_is.tellg());
+      m_is.seekg(0, std::ios::beg);
+    }
+
+    // Read the next chunk, false at the end of the file. A line longer than
+    // the chunk size makes a larger chunk.
+    bool next()
+    {
+      m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_end);
+      m_begin = 0;
+      m_end = 0;
+      while (!m_eof) {
+        const std::size_t size = m_buffer.size();
+        const std::size_t request = size < m_chunk_size
+          ? m_chunk_size - size : m_chunk_size;
+        m_buffer.resize(size + request);
+        m_is.read(&m_buffer[size], static_cast<std::streamsize>(request));
+        m_buffer.resize(size + static_cast<std::size_t>(m_is.gcount()));
+        if (!m_is) {
+          if (m_is.bad()) {
+            boost::throw_exception(std::runtime_error("cannot read "
+              + m_path));
+          }
+          m_eof = true;
+          break;
+        }
+        for (std::size_t i = m_buffer.size(); i > size; --i) {
+          if (m_buffer[i - 1] == '\n') {
+            m_end = i; // the rest is the start of the next chunk
+            return true;
+          }
+        }
+      }
+      if (m_buffer.empty()) return false;
+      if (m_buffer.back() != '\n') m_buffer.push_back('\n');
+      m_end = m_buffer.size();
+      return true;
+    }
+
+    const char* begin() const
+    {
+      return &m_buffer[0] + m_begin;
+    }
+
+    const char* end() const
+    {
+      return &m_buffer[0] + m_end;
+    }
+
+    // Skip the lines of the chunk before p
+    void skip_to(const char* p)
+    {
+      m_begin = static_cast<std::size_t>(p - &m_buffer[0]);
+    }
+
+    std::size_t file_size() const
+    {
+      return m_file_size;
+    }
+
+  private:
+    std::ifstream m_is;
+    std::string m_path;
+    std::size_t m_chunk_size;
+    std::size_t m_file_size;
+    std::vector<char> m_buffer;
+    std::size_t m_begin;
+    std::size_t m_end;
+    bool m_eof;
+  };
+
+  // Split the lines of [first, last) into n blocks of about the same size,
+  // block i is [bounds[i], bounds[i + 1]).
+  inline std::vector<const char*> line_blocks(const char* first,
+    const char* last, std::size_t n)
+  {
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    std::vector<const char*> bounds(1, first);
+    for (std::size_t i = 1; i < n; ++i) {
+      const char* p = first + size * i / n;
+      if (p < bounds.back()) p = bounds.back();
+      while (p != last && p != first && p[-1] != '\n') ++p;
+      bounds.push_back(p);
+    }
+    bounds.push_back(last);
+    return bounds;
+  }
+
+  inline const char* next_line(const char* p)
+  {
+    while (*p != '\n') ++p;
+    return p + 1;
+  }
+
+  // Parse an integer and skip the spaces before it, sets ok to false if
+  // there is no number.
+  inline long long parse_integer(const char*& p, bool& ok)
+  {
+    while (*p == ' ' || *p == '\t') ++p;
+    const bool negative = *p == '-';
+    if (negative) ++p;
+    if (*p < '0' || *p > '9') {
+      ok = false;
+      return 0;
+    }
+    long long value = 0;
+    for (; *p >= '0' && *p <= '9'; ++p) {
+      value = value * 10 + (*p - '0');
+    }
+    return negative ? -value : value;
+  }
+
+  // The "p" line of a DIMACS file, with the number of vertices and arcs.
+  // Coordinate files give no number of arcs. Leaves the reader at the line
+  // after it.
+  inline std::pair<long long, long long> dimacs_problem(
+    line_chunk_reader& reader, const char* format, const std::string& path)
+  {
+    const std::size_t length = std::strlen(format);
+    bool found = false;
+    while (!found && reader.next()) {
+      for (const char* p = reader.begin(); p != reader.end();
+        p = next_line(p)) {
+        if (*p == 'p' && std::strncmp(p, format, length) == 0) {
+          p += length;
+          bool ok = true;
+          const long long n = parse_integer(p, ok);
+          bool has_arcs = true;
+          const long long m = parse_integer(p, has_arcs);
+          if (ok && n >= 0) {
+            reader.skip_to(next_line(p));
+            return std::make_pair(n, m);
+          }
+          found = true;
+          break;
+        }
+        if (*p == 'a' || *p == 'v') { // the problem line comes first
+          found = true;
+          break;
+        }
+      }
+    }
+    boost::throw_exception(std::runtime_error(path
+      + " has no DIMACS problem line"));
+    return std::make_pair(0LL, 0LL);
+  }
+
+  template<typename EdgeList>
+  struct dimacs_arc_parser
+  {
+    typedef typename EdgeList::vertex_type vertex_type;
+    typedef typename EdgeList::weight_type weight_type;
+
+    // Count the arcs of each block
+    void count(std::size_t, std::size_t begin, std::size_t end) const
+    {
+      for (std::size_t b = begin; b < end; ++b) {
+        std::size_t n = 0;
+        for (const char* p = m_bounds[b]; p != m_bounds[b + 1];
+          p = next_line(p)) {
+          if (*p == 'a') ++n;
+        }
+        m_offsets[b + 1] = n;
+      }
+    }
+
+    // Parse the arcs of each block from its offset
+    void parse(std::size_t, std::size_t begin, std::size_t end) const
+    {
+      for (std::size_t b = begin; b < end; ++b) {
+        std::size_t i = m_offsets[b];
+        for (const char* p = m_bounds[b]; p != m_bounds[b + 1];
+          p = next_line(p)) {
+          if (*p != 'a') continue;
+          const char* q = p + 1;
+          bool ok = true;
+          const long long u = parse_integer(q, ok);
+          const long long v = parse_integer(q, ok);
+          const long long w = parse_integer(q, ok);
+          if (!ok || u < 1 || v < 1 || u > m_num_vertices
+            || v > m_num_vertices) {
+            m_failed[b] = 1;
+            break;
+          }
+          m_edges->sources[i] = static_cast<vertex_type>(u - 1);
+          m_edges->targets[i] = static_cast<vertex_type>(v - 1);
+          m_edges->weights[i] = static_cast<weight_type>(w);
+          ++i;
+        }
+      }
+    }
+
+    const char* const* m_bounds;
+    std::size_t* m_offsets;
+    char* m_failed;
+    EdgeList* m_edges;
+    long long m_num_vertices;
+  };
+
+  struct dimacs_coordinate_parser
+  {
+    void operator()(std::size_t, std::size_t begin, std::size_t end) const
+    {
+      for (std::size_t b = begin; b < end; ++b) {
+        for (const char* p = m_bounds[b]; p != m_bounds[b + 1];
+          p = next_line(p)) {
+          if (*p != 'v') continue;
+          const char* q = p + 1;
+          bool ok = true;
+          const long long id = parse_integer(q, ok);
+          const long long x = parse_integer(q, ok);
+          const long long y = parse_integer(q, ok);
+          if (!ok || id < 1 || id > m_num_vertices) {
+            m_failed[b] = 1;
+            break;
+          }
+          (*m_coordinates)[id - 1].x = static_cast<long>(x);
+          (*m_coordinates)[id - 1].y = static_cast<long>(y);
+        }
+      }
+    }
+
+    const char* const* m_bounds;
+    char* m_failed;
+    std::vector<flat_coordinate>* m_coordinates;
+    long long m_num_vertices;
+  };
+
+  struct edge_list_header
+  {
+    char magic[8];             // "BLKEDGES"
+    boost::uint32_t version;
+    boost::uint32_t weight_size;
+    boost::uint64_t num_vertices;
+    boost::uint64_t num_arcs;
+  };
+
+  template<typename T>
+  void read_array(std::istream& is, std::vector<T>& v, std::size_t n)
+  {
+    v.resize(n);
+    if (n > 0 && !is.read(reinterpret_cast<char*>(&v[0]), n * sizeof(T))) {
+      boost::throw_exception(std::runtime_error("truncated edge list"));
+    }
+  }
+
+} // namespace detail
+
+// Read a DIMACS .gr file with num_threads threads
+template<typename EdgeList>
+void read_dimacs_graph(const std::string& path, EdgeList& edges,
+  std::size_t num_threads = 1)
+{
+  detail::line_chunk_reader reader(path);
+  const std::pair<long long, long long> problem
+    = detail::dimacs_problem(reader, "p sp", path);
+
+  // an arc line takes at least 8 bytes, do not trust a larger count
+  std::size_t capacity = reader.file_size() / 8;
+  if (problem.second >= 0
+    && static_cast<unsigned long long>(problem.second) < capacity) {
+    capacity = static_cast<std::size_t>(problem.second);
+  }
+  edges.num_vertices = static_cast<std::size_t>(problem.first);
+  edges.sources.clear();
+  edges.targets.clear();
+  edges.weights.clear();
+  edges.sources.reserve(capacity);
+  edges.targets.reserve(capacity);
+  edges.weights.reserve(capacity);
+
+  const std::size_t num_blocks = num_threads == 0 ? 1 : num_threads;
+  std::vector<std::size_t> offsets(num_blocks + 1);
+  std::vector<char> failed(num_blocks, 0);
+  using namespace std::placeholders;
+  do {
+    const std::vector<const char*> bounds
+      = detail::line_blocks(reader.begin(), reader.end(), num_blocks);
+    detail::dimacs_arc_parser<EdgeList> parser = { &bounds[0], &offsets[0],
+      &failed[0], &edges, problem.first };
+
+    detail::parallel_for_blocks(num_blocks, num_blocks,
+      std::bind(&detail::dimacs_arc_parser<EdgeList>::count, &parser,
+        _1, _2, _3));
+    offsets[0] = edges.sources.size();
+    for (std::size_t b = 0; b < num_blocks; ++b) {
+      offsets[b + 1] += offsets[b];
+    }
+    edges.sources.resize(offsets.back());
+    edges.targets.resize(offsets.back());
+    edges.weights.resize(offsets.back());
+    detail::parallel_for_blocks(num_blocks, num_blocks,
+      std::bind(&detail::dimacs_arc_parser<EdgeList>::parse, &parser,
+        _1, _2, _3));
+
+    for (std::size_t b = 0; b < num_blocks; ++b) {
+      if (failed[b]) {
+        boost::throw_exception(std::runtime_error(path
+          + " has an invalid arc"));
+      }
+    }
+  } while (reader.next());
+}
+
+// Read a DIMACS .co file with num_threads threads, coordinates are by
+// vertex index
+inline std::vector<flat_coordinate> read_dimacs_coordinates(
+  const std::string& path, std::size_t num_threads = 1)
+{
+  detail::line_chunk_reader reader(path);
+  const std::pair<long long, long long> problem
+    = detail::dimacs_problem(reader, "p aux sp co", path);
+
+  const std::size_t num_blocks = num_threads == 0 ? 1 : num_threads;
+  std::vector<char> failed(num_blocks, 0);
+  const flat_coordinate zero = { 0, 0 };
+  std::vector<flat_coordinate> coordinates(
+    static_cast<std::size_t>(problem.first), zero);
+  do {
+    const std::vector<const char*> bounds
+      = detail::line_blocks(reader.begin(), reader.end(), num_blocks);
+    const detail::dimacs_coordinate_parser parser = { &bounds[0],
+      &failed[0], &coordinates, problem.first };
+    detail::parallel_for_blocks(num_blocks, num_blocks, parser);
+
+    for (std::size_t b = 0; b < num_blocks; ++b) {
+      if (failed[b]) {
+        boost::throw_exception(std::runtime_error(path
+          + " has an invalid vertex"));
+      }
+    }
+  } while (reader.next());
+  return coordinates;
+}
+
+// Write the edge list in the binary format of read_edge_list, the stream
+// must be binary
+template<typename EdgeList>
+std::ostream& write_edge_list(std::ostream& os, const EdgeList& edges)
+{
+  typedef typename EdgeList::vertex_type vertex_type;
+  typedef typename EdgeList::weight_type weight_type;
+  detail::edge_list_header header;
+  std::memcpy(header.magic, "BLKEDGES", 8);
+  header.version = 1;
+  header.weight_size = sizeof(weight_type);
+  header.num_vertices = edges.num_vertices;
+  header.num_arcs = edges.sources.size();
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!edges.sources.empty()) {
+    const std::size_t m = edges.sources.size();
+    os.write(reinterpret_cast<const char*>(&edges.sources[0]),
+      m * sizeof(vertex_type));
+    os.write(reinterpret_cast<const char*>(&edges.targets[0]),
+      m * sizeof(vertex_type));
+    os.write(reinterpret_cast<const char*>(&edges.weights[0]),
+      m * sizeof(weight_type));
+  }
+  return os;
+}
+
+// Read a binary edge list written by write_edge_list, with the same weight
+// and vertex types
+template<typename EdgeList>
+void read_edge_list(std::istream& is, EdgeList& edges)
+{
+  typedef typename EdgeList::weight_type weight_type;
+  detail::edge_list_header header;
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))
+    || std::memcmp(header.magic, "BLKEDGES", 8) != 0) {
+    boost::throw_exception(std::runtime_error("not an edge list"));
+  }
+  if (header.version != 1 || header.weight_size != sizeof(weight_type)) {
+    boost::throw_exception(std::runtime_error(
+      "edge list of another version or weight type"));
+  }
+  const std::size_t m = static_cast<std::size_t>(header.num_arcs);
+  edges.num_vertices = static_cast<std::size_t>(header.num_vertices);
+  detail::read_array(is, edges.sources, m);
+  detail::read_array(is, edges.targets, m);
+  detail::read_array(is, edges.weights, m);
+  for (std::size_t i = 0; i < m; ++i) {
+    if (edges.sources[i] >= edges.num_vertices
+      || edges.targets[i] >= edges.num_vertices) {
+      boost::throw_exception(std::runtime_error("corrupt edge list"));
+    }
+  }
+}
+
+template<typename EdgeList>
+void read_edge_list(const std::string& path, EdgeList& edges)
+{
+  std::ifstream is(path.c_str(), std::ios::binary);
+  if (!is) {
+    boost::throw_exception(std::runtime_error("cannot open " + path));
+  }
+  read_edge_list(is, edges);
+}
+
+// Build the flat graph, the edge list can be released afterwards
+template<typename Weight, typename Vertex>
+typename flat_graph<Weight, Vertex>::type
+  make_flat_graph(const flat_edge_list<Weight, Vertex>& edges)
+{
+  typedef typename flat_graph<Weight, Vertex>::type graph_type;
+  typedef detail::flat_edge_at<Vertex> edge_at;
+  typedef boost::transform_iterator<edge_at,
+    boost::counting_iterator<std::size_t> > edge_iterator;
+
+  const std::size_t m = edges.sources.size();
+  const Vertex* sources = m == 0 ? 0 : &edges.sources[0];
+  const Vertex* targets = m == 0 ? 0 : &edges.targets[0];
+  const edge_iterator first(boost::counting_iterator<std::size_t>(0),
+    edge_at(sources, targets));
+  const edge_iterator last(boost::counting_iterator<std::size_t>(m),
+    edge_at(sources, targets));
+  return graph_type(boost::edges_are_unsorted_multi_pass, first, last,
+    edges.weights.begin(), static_cast<Vertex>(edges.num_vertices));
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_FLAT_GRAPH_HPP
@@ -0,0 +1,152 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// fork_dijkstra makes a new resumable_dijkstra that continues from the 
+// current state of another one. The distance, color and predecessor maps 
+// are forked with fork_property_map and the queue with 
+// dijkstra_queue_bgl::fork_smart. 
+//
+// make_forkable_dijkstra makes a search with cow_vector_property_map maps.
+// Forking it shares the maps copy-on-write and copies only the frontier,
+// forking other searches copies the maps and scans the colors.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_FORK_DIJKSTRA_HPP
+#define BLINK_GRAPH_FORK_DIJKSTRA_HPP
+
+#include <blink/graph/dijkstra_parameter_helper.hpp>
+#include <blink/graph/dijkstra_queue.hpp> // dijkstra_queue_bgl
+#include <blink/graph/property_maps/cow_vector_property_map.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/named_function_params.hpp>
+#include <boost/graph/properties.hpp> // two_bit_color_type
+#include <boost/property_map/property_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+
+namespace blink {
+
+// A new search that continues from the current state of dijkstra, with the
+// given graph visitor. Requires the default queue.
+template<typename DijkstraState>
+resumable_dijkstra<DijkstraState> fork_dijkstra(
+  resumable_dijkstra<DijkstraState>& dijkstra, 
+  const typename DijkstraState::template param<boost::graph_visitor_t>::type&
+    visitor)
+{
+  typedef typename DijkstraState::graph_type graph_type;
+  typedef typename DijkstraState::template param<boost::vertex_distance_t>
+    ::type distance_map_type;
+  typedef typename DijkstraState::template param<boost::vertex_index_t>
+    ::type index_map_type;
+  typedef typename DijkstraState::template param<boost::distance_compare_t>
+    ::type compare_type;
+  typedef typename DijkstraState::template param<boost::max_priority_queue_t>
+    ::type queue_type;
+  typedef dijkstra_queue_bgl<graph_type, distance_map_type, index_map_type, 
+    compare_type> queue_traits;
+
+  const graph_type& g = dijkstra.get_graph();
+  const index_map_type& index = dijkstra.get(boost::vertex_index_t());
+
+  distance_map_type distance = fork_property_map(
+    dijkstra.get(boost::vertex_distance_t()), g, index);
+  boost::shared_ptr<queue_type> queue = queue_traits::fork_smart(
+    dijkstra.get(boost::max_priority_queue_t()), g, distance, 
+    dijkstra.get(boost::distance_compare_t()), index, 
+    dijkstra.get(boost::vertex_color_t()));
+
+  DijkstraState state(g, dijkstra.get(boost::edge_weight_t()), index, 
+    distance, 
+    fork_property_map(dijkstra.get(boost::vertex_predecessor_t()), g, index), 
+    fork_property_map(dijkstra.get(boost::vertex_color_t()), g, index), 
+    dijkstra.get(boost::distance_compare_t()), 
+    dijkstra.get(boost::distance_combine_t()), 
+    dijkstra.get(boost::distance_zero_t()), 
+    dijkstra.get(boost::distance_inf_t()), queue, visitor);
+  return resumable_dijkstra<DijkstraState>(state);
+}
+
+// As above with a default constructed graph visitor. The visitor of 
+// dijkstra is not copied, as it may refer to state of that search, such as
+// the discovery list of the searches of a dijkstra_state_pool. 
+template<typename DijkstraState>
+resumable_dijkstra<DijkstraState> fork_dijkstra(
+  resumable_dijkstra<DijkstraState>& dijkstra)
+{
+  typedef typename DijkstraState::template param<boost::graph_visitor_t>
+    ::type visitor_type;
+  return fork_dijkstra(dijkstra, visitor_type());
+}
+
+// extends resumable_dijkstra_helper with cow_vector_property_map for the
+// distance, color and predecessor maps, so that fork_dijkstra is cheap. 
+// Params must not contain these maps or a queue.
+template<typename Graph, typename Params>
+struct forkable_dijkstra_helper
+{
+  typedef dijkstra_parameter_helper<Graph, Params> given;
+  typedef typename given::template param<boost::vertex_index_t>::type 
+    index_map_type;
+  typedef typename boost::property_traits<typename given::template 
+    param<boost::vertex_distance_t>::type>::value_type distance_type;
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor 
+    vertex_descriptor;
+
+  typedef cow_vector_property_map<distance_type, index_map_type> 
+    distance_map_type;
+  typedef cow_vector_property_map<boost::two_bit_color_type, index_map_type>
+    color_map_type;
+  typedef cow_vector_property_map<vertex_descriptor, index_map_type> 
+    predecessor_map_type;
+
+  typedef boost::bgl_named_params<distance_map_type, boost::vertex_distance_t,
+    boost::bgl_named_params<color_map_type, boost::vertex_color_t,
+    boost::bgl_named_params<predecessor_map_type, boost::vertex_predecessor_t,
+    Params> > > params_type;
+
+  typedef typename resumable_dijkstra_helper<Graph, params_type>::type type;
+
+  static type make(const Graph& g, const Params& params)
+  {
+    const index_map_type index = given::make(boost::vertex_index_t(), params,
+      g);
+    const std::size_t n = num_vertices(g);
+    const params_type all(distance_map_type(n, index), 
+      typename params_type::next_type(color_map_type(n, index), 
+      typename params_type::next_type::next_type(predecessor_map_type(n, 
+      index), params)));
+    return resumable_dijkstra_helper<Graph, params_type>::make(g, all);
+  }
+};
+
+// Make a resumable_dijkstra that can be forked cheaply
+template <typename Graph, typename Params>
+typename forkable_dijkstra_helper<Graph, Params>::type 
+  make_forkable_dijkstra(const Graph& g, const Params& params)
+{
+  return forkable_dijkstra_helper<Graph, Params>::make(g, params); 
+}
+
+template <typename Graph>
+typename forkable_dijkstra_helper<Graph, boost::no_named_parameters>::type
+  make_forkable_dijkstra(const Graph& g)
+{
+  return make_forkable_dijkstra(g, boost::no_named_parameters() );
+}
+
+}// namespace blink
+
+#endif //BLINK_GRAPH_FORK_DIJKSTRA_HPP
@@ -0,0 +1,246 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The frontier_tracking_queue wraps the queue of a dijkstra search and
+// keeps the set of queued (gray) vertices as an explicit list alongside
+// it. Passed as max_priority_queue parameter, it makes rebuilding,
+// exporting and importing the frontier O(frontier) instead of the O(V)
+// scan of reset_dijkstra_queue_by_colormap. The free functions work for
+// resumable_dijkstra as well as dijkstra_object.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_FRONTIER_TRACKING_QUEUE_HPP
+#define BLINK_GRAPH_FRONTIER_TRACKING_QUEUE_HPP
+
+#include <blink/graph/dijkstra_queue.hpp> // clear
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/named_function_params.hpp> // max_priority_queue_t
+#include <boost/graph/properties.hpp> // color_traits
+#include <boost/property_map/property_map.hpp>
+#include <boost/range.hpp>
+
+#include <cstddef>
+#include <utility> // pair
+#include <vector>
+
+namespace blink {
+
+template<typename Queue, typename IndexMap>
+struct frontier_tracking_queue
+{
+  typedef typename boost::property_traits<IndexMap>::key_type vertex_descriptor;
+  typedef Queue queue_type;
+  typedef std::vector<vertex_descriptor> frontier_type;
+
+  frontier_tracking_queue(const Queue& queue, std::size_t num_vertices,
+    IndexMap index)
+    : m_queue(queue), m_index(index), m_position(num_vertices, not_queued())
+  {}
+
+  const vertex_descriptor& top() const
+  {
+    return m_queue.top();
+  }
+
+  void pop()
+  {
+    remove(m_queue.top());
+    m_queue.pop();
+  }
+
+  void push(const vertex_descriptor& v)
+  {
+    m_position[get(m_index, v)] = m_frontier.size();
+    m_frontier.push_back(v);
+    m_queue.push(v);
+  }
+
+  void update(const vertex_descriptor& v)
+  {
+    m_queue.update(v);
+  }
+
+  bool empty() const
+  {
+    return m_frontier.empty();
+  }
+
+  std::size_t size() const
+  {
+    return m_frontier.size();
+  }
+
+  bool contains(const vertex_descriptor& v) const
+  {
+    return m_position[get(m_index, v)] != not_queued();
+  }
+
+  inline void clear()
+  {
+    for (std::size_t i = 0; i < m_frontier.size(); ++i) {
+      m_position[get(m_index, m_frontier[i])] = not_queued();
+    }
+    m_frontier.clear();
+    blink::clear(m_queue);
+  }
+
+  // The queued vertices, in no particular order
+  const frontier_type& frontier() const
+  {
+    return m_frontier;
+  }
+
+  // Rebuild the wrapped queue from the frontier, for instance after the
+  // distances of queued vertices were changed outside the queue.
+  void rebuild()
+  {
+    blink::clear(m_queue);
+    for (std::size_t i = 0; i < m_frontier.size(); ++i) {
+      m_queue.push(m_frontier[i]);
+    }
+  }
+
+private:
+  static std::size_t not_queued()
+  {
+    return std::size_t(-1);
+  }
+
+  // swap with the last vertex of the frontier
+  void remove(const vertex_descriptor& v)
+  {
+    const std::size_t i = m_position[get(m_index, v)];
+    const vertex_descriptor last = m_frontier.back();
+    m_frontier[i] = last;
+    m_position[get(m_index, last)] = i;
+    m_frontier.pop_back();
+    m_position[get(m_index, v)] = not_queued();
+  }
+
+  Queue m_queue;
+  IndexMap m_index;
+  frontier_type m_frontier;
+  std::vector<std::size_t> m_position;
+};
+
+// Wrap the default dijkstra queue
+template <typename Graph, typename DistanceMap, typename IndexMap,
+  typename Compare>
+struct frontier_tracking_queue_bgl
+{
+  typedef dijkstra_queue_bgl<Graph, DistanceMap, IndexMap, Compare> traits;
+  typedef frontier_tracking_queue<typename traits::type, IndexMap> type;
+
+  static type make(const Graph& graph, DistanceMap distance, Compare compare,
+    IndexMap index)
+  {
+    return type(traits::make(graph, distance, compare, index),
+      num_vertices(graph), index);
+  }
+};
+
+template <typename Graph, typename DistanceMap, typename IndexMap,
+  typename Compare>
+typename frontier_tracking_queue_bgl<Graph, DistanceMap, IndexMap,
+  Compare>::type
+  make_frontier_tracking_queue(const Graph& graph, DistanceMap distance,
+    Compare compare, IndexMap index)
+{
+  return frontier_tracking_queue_bgl<Graph, DistanceMap, IndexMap,
+    Compare>::make(graph, distance, compare, index);
+}
+
+// Rebuild the wrapped queue from the frontier, O(frontier)
+template<typename Queue, typename IndexMap>
+void reset_dijkstra_queue_by_frontier(
+  frontier_tracking_queue<Queue, IndexMap>& queue)
+{
+  queue.rebuild();
+}
+
+// Fill another queue with the frontier, O(frontier)
+template<typename Queue, typename IndexMap, typename DijkstraQueue>
+void reset_dijkstra_queue_by_frontier(
+  const frontier_tracking_queue<Queue, IndexMap>& from, DijkstraQueue& to)
+{
+  clear(to);
+  typename frontier_tracking_queue<Queue, IndexMap>::frontier_type
+    ::const_iterator i = from.frontier().begin();
+  for (; i != from.frontier().end(); ++i) {
+    to.push(*i);
+  }
+}
+
+// The queued vertices of a search and their distances. The search must
+// use a frontier_tracking_queue.
+template<typename Dijkstra>
+std::vector<std::pair
+  < typename Dijkstra::template param<boost::vertex_index_t>::type::key_type
+  , typename boost::property_traits<typename Dijkstra::template
+    param<boost::vertex_distance_t>::type>::value_type> >
+  export_frontier(Dijkstra& dijkstra)
+{
+  typedef typename Dijkstra::template param<boost::vertex_index_t>::type
+    ::key_type vertex_descriptor;
+  typedef typename boost::property_traits<typename Dijkstra::template
+    param<boost::vertex_distance_t>::type>::value_type distance_type;
+  typedef typename Dijkstra::template param<boost::max_priority_queue_t>::type
+    queue_type;
+
+  const queue_type& queue = dijkstra.get(boost::max_priority_queue_t());
+  std::vector<std::pair<vertex_descriptor, distance_type> > frontier;
+  frontier.reserve(queue.size());
+  typename queue_type::frontier_type::const_iterator i
+    = queue.frontier().begin();
+  for (; i != queue.frontier().end(); ++i) {
+    frontier.push_back(std::make_pair(*i,
+      get(dijkstra.get(boost::vertex_distance_t()), *i)));
+  }
+  return frontier;
+}
+
+// Queue (vertex, distance) pairs, for instance exported from another
+// search. White vertices become gray, gray vertices are updated if the
+// distance is smaller, black vertices are left alone.
+template<typename Dijkstra, typename FrontierRange>
+void import_frontier(Dijkstra& dijkstra, const FrontierRange& frontier)
+{
+  typedef typename Dijkstra::template param<boost::vertex_color_t>::type
+    color_map_type;
+  typedef typename boost::property_traits<color_map_type>::value_type
+    color_type;
+  typedef boost::color_traits<color_type> color_traits;
+
+  typename boost::range_iterator<const FrontierRange>::type
+    i = boost::begin(frontier), end = boost::end(frontier);
+  for (; i != end; ++i) {
+    const color_type c = get(dijkstra.get(boost::vertex_color_t()), i->first);
+    if (c == color_traits::white()) {
+      put(dijkstra.get(boost::vertex_color_t()), i->first,
+        color_traits::gray());
+      put(dijkstra.get(boost::vertex_distance_t()), i->first, i->second);
+      put(dijkstra.get(boost::vertex_predecessor_t()), i->first, i->first);
+      dijkstra.get(boost::max_priority_queue_t()).push(i->first);
+    } else if (c == color_traits::gray()
+      && dijkstra.get(boost::distance_compare_t())(i->second,
+        get(dijkstra.get(boost::vertex_distance_t()), i->first))) {
+      put(dijkstra.get(boost::vertex_distance_t()), i->first, i->second);
+      put(dijkstra.get(boost::vertex_predecessor_t()), i->first, i->first);
+      dijkstra.get(boost::max_priority_queue_t()).update(i->first);
+    }
+  }
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_FRONTIER_TRACKING_QUEUE_HPP
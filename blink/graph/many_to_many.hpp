@@ -0,0 +1,321 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Many-to-many distance tables with buckets. First a backward search is
+// run from every target, up to a radius. Every vertex it reaches gets an
+// entry (target, distance to target) in its bucket. Then a forward search
+// is run from every source, that scans the bucket of every vertex it
+// finishes. The forward search stops as soon as the distances to all
+// targets are known to be final.
+//
+// For a target t with backward radius R_t, a shortest path from s leaves
+// the vertices finished by the backward search through a vertex whose
+// bucket entry is exact and that lies at least R_t from t. So d(s,t) is
+// final once the forward search has finished all vertices within
+// best(s,t) - R_t of s. When the backward search was not interrupted R_t
+// is inf, and the source bucket alone is enough.
+//
+// Both phases run in parallel on a thread_pool using dijkstra_batch. The
+// graph must be bidirectional, internal edge_weight and vertex_index maps
+// are used. Distances are combined with + and compared with <.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_MANY_TO_MANY_HPP
+#define BLINK_GRAPH_MANY_TO_MANY_HPP
+
+#include <blink/graph/dijkstra_batch.hpp>
+#include <blink/graph/dijkstra_visitor/distance_visitor.hpp>
+#include <blink/graph/dijkstra_visitor/joined_visitor.hpp>
+#include <blink/graph/dijkstra_visitor/record_discovery_visitor.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+#include <blink/graph/thread_pool.hpp>
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/graph/reverse_graph.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/range.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <iterator> // back_inserter
+#include <limits>
+#include <utility> // pair
+#include <vector>
+
+namespace blink {
+
+// The buckets of all vertices, in compressed form: the entries of the
+// vertex with index i are entries[offsets[i]] to entries[offsets[i + 1]].
+template<typename Distance>
+struct many_to_many_buckets
+{
+  typedef std::pair<std::size_t, Distance> entry_type; // target column
+
+  std::vector<std::size_t> offsets;
+  std::vector<entry_type> entries;
+  std::vector<Distance> radius; // per target column
+};
+
+namespace detail {
+
+template<typename Distance>
+struct many_to_many_backward_job
+{
+  typedef std::vector<std::pair<std::size_t, Distance> > list_type;
+
+  many_to_many_backward_job(std::vector<list_type>& lists,
+    std::vector<Distance>& radius, Distance max_radius)
+    : m_lists(&lists), m_radius(&radius), m_max_radius(max_radius)
+  {}
+
+  template<typename DijkstraState, typename Vertex>
+  void operator()(resumable_dijkstra<DijkstraState>& dijkstra,
+    const Vertex& target, std::size_t i)
+  {
+    typedef typename distance_visitor_helper<DijkstraState>::type
+      interruptor_type;
+    typedef std::back_insert_iterator<std::vector<Vertex> > inserter_type;
+
+    std::vector<Vertex> discovered;
+    interruptor_type interruptor = make_distance_visitor(
+      dijkstra.get_dijkstra_state(), m_max_radius);
+    joined_visitor<interruptor_type, record_discovery_visitor<inserter_type> >
+      visitor = make_joined_visitor(interruptor,
+        make_record_discovery_visitor(std::back_inserter(discovered)));
+
+    dijkstra.put_source(target, visitor);
+    const bool complete = dijkstra.expand(interruptor, visitor);
+
+    (*m_radius)[i] = complete ? (std::numeric_limits<Distance>::max)()
+      : m_max_radius;
+
+    list_type& list = (*m_lists)[i];
+    list.reserve(discovered.size());
+    typename std::vector<Vertex>::const_iterator v = discovered.begin();
+    for (; v != discovered.end(); ++v) {
+      list.push_back(std::make_pair(
+        std::size_t(get(dijkstra.get(boost::vertex_index_t()), *v)),
+        get(dijkstra.get(boost::vertex_distance_t()), *v)));
+    }
+  }
+
+  std::vector<list_type>* m_lists;
+  std::vector<Distance>* m_radius;
+  Distance m_max_radius;
+};
+
+// Scans the buckets of finished vertices into one row of the output. Also
+// the interruptor of the forward search.
+template<typename DistanceMap, typename IndexMap, typename RowIterator>
+class many_to_many_forward_visitor : public boost::default_dijkstra_visitor
+{
+  typedef typename boost::property_traits<DistanceMap>::value_type
+    distance_type;
+
+public:
+  many_to_many_forward_visitor(DistanceMap distance, IndexMap index,
+    const many_to_many_buckets<distance_type>& buckets, RowIterator row)
+    : m_distance(distance), m_index(index), m_buckets(&buckets), m_row(row)
+    , m_do_interrupt(new bool(false))
+    , m_next_check(new distance_type(distance_type()))
+  {}
+
+  template<typename U, typename G>
+  void finish_vertex(const U& u, const G& g)
+  {
+    const distance_type r = get(m_distance, u);
+    const std::size_t i = get(m_index, u);
+    const std::size_t end = m_buckets->offsets[i + 1];
+    for (std::size_t k = m_buckets->offsets[i]; k != end; ++k) {
+      const distance_type d = r + m_buckets->entries[k].second;
+      distance_type& best = m_row[m_buckets->entries[k].first];
+      if (d < best) {
+        best = d;
+      }
+    }
+
+    // The threshold best - R_t can only decrease, so it only needs to be
+    // recomputed when r passes the previous one.
+    if (!(r < *m_next_check)) {
+      *m_next_check = threshold();
+      if (!(r < *m_next_check)) {
+        *m_do_interrupt = true;
+      }
+    }
+  }
+
+  inline bool do_interrupt() const
+  {
+    return *m_do_interrupt;
+  }
+
+private:
+  // The distance up to which the forward search must run
+  distance_type threshold() const
+  {
+    const distance_type inf = (std::numeric_limits<distance_type>::max)();
+    distance_type t = distance_type();
+    for (std::size_t j = 0; j < m_buckets->radius.size(); ++j) {
+      const distance_type radius = m_buckets->radius[j];
+      if (radius == inf) {
+        continue;
+      }
+      const distance_type best = m_row[j];
+      if (best == inf) {
+        return inf;
+      }
+      // best - radius would underflow for unsigned distances
+      const distance_type need = radius < best ? best - radius 
+        : distance_type();
+      if (t < need) {
+        t = need;
+      }
+    }
+    return t;
+  }
+
+  DistanceMap m_distance;
+  IndexMap m_index;
+  const many_to_many_buckets<distance_type>* m_buckets;
+  RowIterator m_row;
+  boost::shared_ptr<bool> m_do_interrupt;
+  boost::shared_ptr<distance_type> m_next_check;
+};
+
+template<typename Distance, typename RandomAccessIterator>
+struct many_to_many_forward_job
+{
+  many_to_many_forward_job(const many_to_many_buckets<Distance>& buckets,
+    RandomAccessIterator out)
+    : m_buckets(&buckets), m_out(out)
+  {}
+
+  template<typename DijkstraState, typename Vertex>
+  void operator()(resumable_dijkstra<DijkstraState>& dijkstra,
+    const Vertex& source, std::size_t i)
+  {
+    typedef typename DijkstraState::template param<boost::vertex_distance_t>
+      ::type distance_map_type;
+    typedef typename DijkstraState::template param<boost::vertex_index_t>
+      ::type index_map_type;
+    typedef many_to_many_forward_visitor<distance_map_type, index_map_type,
+      RandomAccessIterator> visitor_type;
+
+    const std::size_t n = m_buckets->radius.size();
+    RandomAccessIterator row = m_out + i * n;
+    for (std::size_t j = 0; j < n; ++j) {
+      row[j] = (std::numeric_limits<Distance>::max)();
+    }
+
+    visitor_type visitor(dijkstra.get(boost::vertex_distance_t()),
+      dijkstra.get(boost::vertex_index_t()), *m_buckets, row);
+    dijkstra.put_source(source, visitor);
+    dijkstra.expand(visitor, visitor);
+  }
+
+  const many_to_many_buckets<Distance>* m_buckets;
+  RandomAccessIterator m_out;
+};
+
+} // namespace detail
+
+// Run the backward searches from all targets, up to max_radius, and
+// collect their buckets.
+template<typename Graph, typename VerticesRange>
+many_to_many_buckets<typename boost::property_traits<typename
+  boost::property_map<Graph, boost::edge_weight_t>::const_type>::value_type>
+  make_many_to_many_buckets(const Graph& g, const VerticesRange& targets,
+    thread_pool& pool,
+    typename boost::property_traits<typename boost::property_map<Graph,
+      boost::edge_weight_t>::const_type>::value_type max_radius)
+{
+  typedef typename boost::property_traits<typename boost::property_map<
+    Graph, boost::edge_weight_t>::const_type>::value_type distance_type;
+  typedef detail::many_to_many_backward_job<distance_type> job_type;
+  typedef typename job_type::list_type list_type;
+  typedef boost::reverse_graph<Graph> reverse_graph_type;
+
+  const std::size_t num_targets = boost::size(targets);
+  std::vector<list_type> lists(num_targets);
+  many_to_many_buckets<distance_type> buckets;
+  buckets.radius.resize(num_targets);
+
+  reverse_graph_type reverse(g);
+  dijkstra_batch<reverse_graph_type> batch(reverse, pool);
+  batch.run(targets, job_type(lists, buckets.radius, max_radius), 1);
+
+  // counting sort of the entries by vertex
+  buckets.offsets.assign(num_vertices(g) + 1, 0);
+  for (std::size_t t = 0; t < num_targets; ++t) {
+    typename list_type::const_iterator i = lists[t].begin();
+    for (; i != lists[t].end(); ++i) {
+      ++buckets.offsets[i->first + 1];
+    }
+  }
+  for (std::size_t v = 1; v < buckets.offsets.size(); ++v) {
+    buckets.offsets[v] += buckets.offsets[v - 1];
+  }
+  buckets.entries.resize(buckets.offsets.back());
+  std::vector<std::size_t> next(buckets.offsets.begin(),
+    buckets.offsets.end() - 1);
+  for (std::size_t t = 0; t < num_targets; ++t) {
+    typename list_type::const_iterator i = lists[t].begin();
+    for (; i != lists[t].end(); ++i) {
+      buckets.entries[next[i->first]++] = std::make_pair(t, i->second);
+    }
+    list_type().swap(lists[t]);
+  }
+  return buckets;
+}
+
+// Write the distance from every source to every target in row-major order:
+// out[source_index * num_targets + target_index]. Unreachable targets get
+// std::numeric_limits<distance>::max(). The backward searches stop at
+// max_radius, a smaller radius uses less memory for buckets but makes the
+// forward searches longer.
+template<typename Graph, typename SourceRange, typename TargetRange,
+  typename RandomAccessIterator>
+void many_to_many_distances(const Graph& g, const SourceRange& sources,
+  const TargetRange& targets, RandomAccessIterator out, thread_pool& pool,
+  typename boost::property_traits<typename boost::property_map<Graph,
+    boost::edge_weight_t>::const_type>::value_type max_radius)
+{
+  typedef typename boost::property_traits<typename boost::property_map<
+    Graph, boost::edge_weight_t>::const_type>::value_type distance_type;
+  typedef detail::many_to_many_forward_job<distance_type,
+    RandomAccessIterator> job_type;
+
+  many_to_many_buckets<distance_type> buckets
+    = make_many_to_many_buckets(g, targets, pool, max_radius);
+
+  dijkstra_batch<Graph> batch(g, pool);
+  batch.run(sources, job_type(buckets, out), 1);
+}
+
+// Without radius, the backward searches are exhaustive
+template<typename Graph, typename SourceRange, typename TargetRange,
+  typename RandomAccessIterator>
+void many_to_many_distances(const Graph& g, const SourceRange& sources,
+  const TargetRange& targets, RandomAccessIterator out, thread_pool& pool)
+{
+  typedef typename boost::property_traits<typename boost::property_map<
+    Graph, boost::edge_weight_t>::const_type>::value_type distance_type;
+
+  many_to_many_distances(g, sources, targets, out, pool,
+    (std::numeric_limits<distance_type>::max)());
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_MANY_TO_MANY_HPP
@@ -0,0 +1,382 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// A shortest path search for K sources at once. Every vertex holds an array
+// of K distances (lanes), all lanes are relaxed together when an edge is
+// scanned, so the adjacency of a vertex is loaded once for K searches.
+//
+// The search is label-correcting: the queue is ordered by the smallest
+// lane that decreased since the vertex was last scanned, and a finished
+// vertex is queued again when one of its lanes decreases. Vertices can
+// therefore be examined (and finished) more than once. The fewer the
+// lanes disagree, i.e. the nearer the sources, the closer this is to a
+// single Dijkstra search. The distances are exact once the queue is empty.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_MULTI_LANE_DIJKSTRA_HPP
+#define BLINK_GRAPH_MULTI_LANE_DIJKSTRA_HPP
+
+#include <blink/graph/breadth_first_search.hpp> // breadth_first_visit_no_init
+#include <blink/graph/dijkstra_queue.hpp>
+#include <blink/graph/property_maps/lane_property_map.hpp>
+#include <blink/graph/property_maps/vertex_property_map_helper.hpp>
+#include <blink/graph/relax.hpp> // relax_lanes
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/exception.hpp> // negative_edge
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/graph/two_bit_color_map.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/range.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/tuple/tuple.hpp> //tie
+
+#include <array>
+#include <cstddef>
+#include <functional> // std::less, std::plus
+#include <limits>
+
+namespace blink {
+
+namespace detail {
+
+// The BFS visitor for the multi-lane search, analogous to
+// dijkstra_bfs_visitor. The UniformCostVisitor sees the same events as in
+// a dijkstra search, except that examine_vertex and finish_vertex can be
+// repeated for a vertex.
+template <class UniformCostVisitor, class UpdatableQueue, class WeightMap,
+  class LanesMap, class KeyMap, class ColorMap, class BinaryFunction,
+  class BinaryPredicate>
+struct multi_lane_bfs_visitor
+{
+  typedef typename boost::property_traits<LanesMap>::value_type lanes_type;
+  typedef typename boost::property_traits<KeyMap>::value_type D;
+  typedef typename boost::property_traits<ColorMap>::value_type color_type;
+  typedef boost::color_traits<color_type> color_traits;
+
+  multi_lane_bfs_visitor(UniformCostVisitor vis, UpdatableQueue& Q,
+    WeightMap w, LanesMap lanes, KeyMap key, ColorMap color,
+    BinaryFunction combine, BinaryPredicate compare, D zero, D inf)
+    : m_vis(vis), m_Q(Q), m_weight(w), m_lanes(lanes), m_key(key)
+    , m_color(color), m_combine(combine), m_compare(compare), m_zero(zero)
+    , m_inf(inf)
+  { }
+
+  // The LanesMap is an lvalue map, the lanes of the target are relaxed in
+  // place instead of copying both arrays for every edge.
+  template <class Edge, class Graph>
+  bool relax(Edge e, Graph& g, D& min_decreased)
+  {
+    const lanes_type& d_u = m_lanes[source(e, g)];
+    lanes_type& d_v = m_lanes[target(e, g)];
+    min_decreased = m_inf;
+    return relax_lanes(d_u, d_v, get(m_weight, e), m_combine, m_compare, 
+      m_inf, min_decreased);
+  }
+
+  // The target is pushed on the queue by breadth_first_visit_no_init
+  template <class Edge, class Graph>
+  void tree_edge(Edge e, Graph& g)
+  {
+    D min_decreased;
+    relax(e, g, min_decreased);
+    put(m_key, target(e, g), min_decreased);
+    m_vis.edge_relaxed(e, g);
+  }
+
+  template <class Edge, class Graph>
+  void gray_target(Edge e, Graph& g)
+  {
+    D min_decreased;
+    if (relax(e, g, min_decreased)) {
+      if (m_compare(min_decreased, get(m_key, target(e, g)))) {
+        put(m_key, target(e, g), min_decreased);
+        m_Q.update(target(e, g));
+      }
+      m_vis.edge_relaxed(e, g);
+    } else {
+      m_vis.edge_not_relaxed(e, g);
+    }
+  }
+
+  // Queue the finished target again
+  template <class Edge, class Graph>
+  void black_target(Edge e, Graph& g)
+  {
+    D min_decreased;
+    if (relax(e, g, min_decreased)) {
+      put(m_key, target(e, g), min_decreased);
+      put(m_color, target(e, g), color_traits::gray());
+      m_Q.push(target(e, g));
+      m_vis.edge_relaxed(e, g);
+    } else {
+      m_vis.edge_not_relaxed(e, g);
+    }
+  }
+
+  template <class Vertex, class Graph>
+  void initialize_vertex(Vertex u, Graph& g)
+  {
+    m_vis.initialize_vertex(u, g);
+  }
+
+  template <class Edge, class Graph>
+  void non_tree_edge(Edge, Graph&)
+  { }
+
+  template <class Vertex, class Graph>
+  void discover_vertex(Vertex u, Graph& g)
+  {
+    m_vis.discover_vertex(u, g);
+  }
+
+  template <class Vertex, class Graph>
+  void examine_vertex(Vertex u, Graph& g)
+  {
+    m_vis.examine_vertex(u, g);
+  }
+
+  template <class Edge, class Graph>
+  void examine_edge(Edge e, Graph& g)
+  {
+    if (m_compare(get(m_weight, e), m_zero)) {
+        boost::throw_exception(boost::negative_edge());
+    }
+    m_vis.examine_edge(e, g);
+  }
+
+  template <class Vertex, class Graph>
+  void finish_vertex(Vertex u, Graph& g)
+  {
+    m_vis.finish_vertex(u, g);
+  }
+
+  UniformCostVisitor m_vis;
+  UpdatableQueue& m_Q;
+  WeightMap m_weight;
+  LanesMap m_lanes;
+  KeyMap m_key;
+  ColorMap m_color;
+  BinaryFunction m_combine;
+  BinaryPredicate m_compare;
+  D m_zero;
+  D m_inf;
+};
+
+} // namespace detail
+
+template<typename Graph, std::size_t K
+  , typename WeightMap
+    = typename boost::property_map<Graph, boost::edge_weight_t>::const_type
+  , typename IndexMap
+    = typename boost::property_map<Graph, boost::vertex_index_t>::const_type
+  , typename Compare
+    = std::less<typename boost::property_traits<WeightMap>::value_type>
+  , typename Combine
+    = std::plus<typename boost::property_traits<WeightMap>::value_type> >
+class multi_lane_dijkstra
+{
+public:
+  typedef typename boost::graph_traits<Graph>::vertex_descriptor vertex_descriptor;
+  typedef typename boost::graph_traits<Graph>::vertex_iterator vertex_iterator;
+  typedef typename boost::property_traits<WeightMap>::value_type distance_type;
+  typedef std::array<distance_type, K> lanes_type;
+
+  typedef typename vertex_property_map_helper<lanes_type, Graph, IndexMap>::type
+    lanes_map_type;
+  typedef typename vertex_property_map_helper<distance_type, Graph, IndexMap>::type
+    key_map_type;
+  typedef typename vertex_property_map_helper<boost::two_bit_color_type, Graph
+    , IndexMap, boost::two_bit_color_map<IndexMap> >::type color_map_type;
+  typedef dijkstra_queue_bgl<Graph, key_map_type, IndexMap, Compare> queue_helper;
+  typedef typename queue_helper::type queue_type;
+
+  typedef lane_property_map<lanes_map_type> lane_distance_map_type;
+
+  static const std::size_t num_lanes = K;
+
+  multi_lane_dijkstra(const Graph& graph, WeightMap weight, IndexMap index,
+    Compare compare = Compare(), Combine combine = Combine(),
+    distance_type zero = distance_type(),
+    distance_type inf = (std::numeric_limits<distance_type>::max)())
+    : m_graph(graph), m_weight(weight), m_index(index)
+    , m_lanes(vertex_property_map_helper<lanes_type, Graph, IndexMap>::make(
+      graph, index))
+    , m_key(vertex_property_map_helper<distance_type, Graph, IndexMap>::make(
+      graph, index))
+    , m_color(vertex_property_map_helper<boost::two_bit_color_type, Graph
+      , IndexMap, boost::two_bit_color_map<IndexMap> >::make(graph, index))
+    , m_compare(compare), m_combine(combine), m_zero(zero), m_inf(inf)
+    , m_queue(queue_helper::make_smart(graph, m_key, compare, index))
+  {}
+
+  // Expand the search until the Interruptor returns true on do_interrupt()
+  template<typename Interruptor, typename Visitor>
+  bool expand(Interruptor interruptor, Visitor vis)
+  {
+    typedef detail::multi_lane_bfs_visitor<Visitor, queue_type, WeightMap,
+      lanes_map_type, key_map_type, color_map_type, Combine, Compare>
+      bfs_visitor_type;
+
+    bfs_visitor_type bfs_vis(vis, *m_queue, m_weight, m_lanes, m_key,
+      m_color, m_combine, m_compare, m_zero, m_inf);
+    breadth_first_visit_no_init(m_graph, *m_queue, bfs_vis, m_color,
+      interruptor);
+    return m_queue->empty();
+  }
+
+  template<typename Interruptor>
+  bool expand(Interruptor interruptor)
+  {
+    return expand(interruptor, boost::default_dijkstra_visitor());
+  }
+
+  bool expand()
+  {
+    return expand(default_interruptor(), boost::default_dijkstra_visitor());
+  }
+
+  // Set all lanes of all vertices to inf and empty the queue
+  template<typename Visitor>
+  void init_all(Visitor vis)
+  {
+    lanes_type inf_lanes;
+    inf_lanes.fill(m_inf);
+
+    vertex_iterator ui, ui_end;
+    for (boost::tie(ui, ui_end) = vertices(m_graph); ui != ui_end; ++ui) {
+      vis.initialize_vertex(*ui, m_graph);
+      put(m_color, *ui, color_traits::white());
+      put(m_lanes, *ui, inf_lanes);
+      put(m_key, *ui, m_inf);
+    }
+    clear(*m_queue);
+  }
+
+  void init_all()
+  {
+    init_all(boost::default_dijkstra_visitor());
+  }
+
+  // Set the source of one lane
+  template<typename Visitor>
+  void put_source(std::size_t lane, vertex_descriptor source, Visitor vis)
+  {
+    lanes_type d = boost::get(m_lanes, source);
+    d[lane] = m_zero;
+    put(m_lanes, source, d);
+
+    const color_type c = boost::get(m_color, source);
+    if (c == color_traits::gray()) {
+      put(m_key, source, m_zero);
+      m_queue->update(source);
+    } else {
+      put(m_key, source, m_zero);
+      put(m_color, source, color_traits::gray());
+      m_queue->push(source);
+      if (c == color_traits::white()) {
+        vis.discover_vertex(source, m_graph);
+      }
+    }
+  }
+
+  void put_source(std::size_t lane, vertex_descriptor source)
+  {
+    put_source(lane, source, boost::default_dijkstra_visitor());
+  }
+
+  // Set the sources of the first boost::size(r) lanes
+  template<typename VerticesRange, typename Visitor>
+  void put_sources(const VerticesRange& r, Visitor vis)
+  {
+    typename boost::range_iterator<const VerticesRange>::type i
+      = boost::begin(r);
+    const typename boost::range_iterator<const VerticesRange>::type end
+      = boost::end(r);
+    for(std::size_t lane = 0; i != end && lane < K; ++i, ++lane) {
+      put_source(lane, *i, vis);
+    }
+  }
+
+  template<typename VerticesRange>
+  void init_from_sources(const VerticesRange& r)
+  {
+    init_all(boost::default_dijkstra_visitor());
+    put_sources(r, boost::default_dijkstra_visitor());
+  }
+
+  template<typename VerticesRange, typename Visitor>
+  void init_from_sources(const VerticesRange& r, Visitor vis)
+  {
+    init_all(vis);
+    put_sources(r, vis);
+  }
+
+  // The distances of one lane, as a distance map of the single search
+  lane_distance_map_type get(boost::vertex_distance_t, std::size_t lane) const
+  {
+    return lane_distance_map_type(m_lanes, lane);
+  }
+
+  lanes_map_type get(boost::vertex_distance_t) const
+  {
+    return m_lanes;
+  }
+
+  color_map_type get(boost::vertex_color_t) const
+  {
+    return m_color;
+  }
+
+  const Graph& get_graph() const
+  {
+    return m_graph;
+  }
+
+private:
+  typedef typename boost::property_traits<color_map_type>::value_type color_type;
+  typedef boost::color_traits<color_type> color_traits;
+
+  const Graph& m_graph;
+  WeightMap m_weight;
+  IndexMap m_index;
+  lanes_map_type m_lanes;
+  key_map_type m_key;
+  color_map_type m_color;
+  Compare m_compare;
+  Combine m_combine;
+  distance_type m_zero;
+  distance_type m_inf;
+  boost::shared_ptr<queue_type> m_queue;
+};
+
+// Make a multi_lane_dijkstra with K lanes, using the internal edge_weight
+// and vertex_index maps.
+template<std::size_t K, typename Graph>
+multi_lane_dijkstra<Graph, K> make_multi_lane_dijkstra(const Graph& g)
+{
+  return multi_lane_dijkstra<Graph, K>(g, get(boost::edge_weight, g),
+    get(boost::vertex_index, g));
+}
+
+template<std::size_t K, typename Graph, typename WeightMap, typename IndexMap>
+multi_lane_dijkstra<Graph, K, WeightMap, IndexMap>
+  make_multi_lane_dijkstra(const Graph& g, WeightMap weight, IndexMap index)
+{
+  return multi_lane_dijkstra<Graph, K, WeightMap, IndexMap>(g, weight, index);
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_MULTI_LANE_DIJKSTRA_HPP
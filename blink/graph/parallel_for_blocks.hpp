@@ -0,0 +1,82 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// parallel_for_blocks splits a range of indices into contiguous blocks and
+// processes each block on its own thread, the calling thread takes the
+// first block. It starts the threads for each call, for repeated phases on
+// the same threads see detail::block_team in delta_stepping.hpp.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_PARALLEL_FOR_BLOCKS_HPP
+#define BLINK_GRAPH_PARALLEL_FOR_BLOCKS_HPP
+
+#include <cstddef>
+#include <exception>
+#include <functional> // cref, ref
+#include <thread>
+#include <vector>
+
+namespace blink {
+
+namespace detail {
+
+template<typename Function>
+void run_block(const Function& f, std::size_t thread, std::size_t begin,
+  std::size_t end, std::exception_ptr& exception)
+{
+  try {
+    f(thread, begin, end);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+}
+
+// Split [0, n) into num_threads contiguous blocks and call f(thread, begin,
+// end) for each block on its own thread. Returns after all blocks are done,
+// rethrowing the first exception thrown by f.
+template<typename Function>
+void parallel_for_blocks(std::size_t num_threads, std::size_t n, Function f)
+{
+  if (num_threads <= 1 || n < 2) {
+    f(std::size_t(0), std::size_t(0), n);
+    return;
+  }
+  if (num_threads > n) {
+    num_threads = n;
+  }
+  const std::size_t block = (n + num_threads - 1) / num_threads;
+  std::vector<std::exception_ptr> exceptions(num_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (std::size_t t = 1; t < num_threads; ++t) {
+    const std::size_t begin = t * block < n ? t * block : n;
+    const std::size_t end = begin + block < n ? begin + block : n;
+    threads.push_back(std::thread(&run_block<Function>, std::cref(f), t,
+      begin, end, std::ref(exceptions[t])));
+  }
+  run_block(f, std::size_t(0), std::size_t(0), block < n ? block : n,
+    exceptions[0]);
+  for (std::size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+  for (std::size_t t = 0; t < exceptions.size(); ++t) {
+    if (exceptions[t]) {
+      std::rethrow_exception(exceptions[t]);
+    }
+  }
+}
+
+} // namespace detail
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_PARALLEL_FOR_BLOCKS_HPP
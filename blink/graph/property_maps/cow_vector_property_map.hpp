@@ -0,0 +1,204 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The cow_vector_property_map is a vertex property map that stores its
+// values in fixed size chunks with a reference count each. Copies of the
+// map share all values, like shared_array_property_map. A fork() shares
+// the chunks copy-on-write: a chunk is copied when it is written to while
+// another fork still uses it. All chunks start out as the same chunk, so
+// memory grows only with the chunks that are written to.
+//
+// Not thread-safe, forks must be used from the same thread.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_COW_VECTOR_PROPERTY_MAP_HPP
+#define BLINK_COW_VECTOR_PROPERTY_MAP_HPP
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/iteration_macros.hpp>
+#include <boost/graph/property_maps/null_property_map.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace blink
+{
+  template<typename T, typename IndexMap>
+  class cow_vector_property_map
+  {
+  public:
+    typedef typename boost::property_traits<IndexMap>::key_type key_type;
+    typedef T value_type;
+    typedef T reference;
+    typedef boost::read_write_property_map_tag category;
+
+    static const std::size_t chunk_bits = 10; // 1024 values per chunk
+
+    cow_vector_property_map()
+    {}
+
+    cow_vector_property_map(std::size_t n, IndexMap index,
+      const T& initial = T())
+      : m_chunks(new chunk_vector(num_chunks(n))), m_index(index)
+    {
+      boost::shared_ptr<chunk> c(new chunk(chunk_size(), initial));
+      for (std::size_t i = 0; i < m_chunks->size(); ++i) {
+        (*m_chunks)[i] = c;
+      }
+    }
+
+    // A map that shares all chunks copy-on-write with this one
+    cow_vector_property_map fork() const
+    {
+      cow_vector_property_map m;
+      m.m_chunks.reset(new chunk_vector(*m_chunks));
+      m.m_index = m_index;
+      return m;
+    }
+
+    T get(const key_type& key) const
+    {
+      const std::size_t i = boost::get(m_index, key);
+      return (*(*m_chunks)[i >> chunk_bits])[i & mask()];
+    }
+
+    void put(const key_type& key, const T& value) const
+    {
+      const std::size_t i = boost::get(m_index, key);
+      boost::shared_ptr<chunk>& c = (*m_chunks)[i >> chunk_bits];
+      T& v = (*c)[i & mask()];
+      if (v == value) {
+        return;
+      }
+      if (c.use_count() > 1) {
+        c.reset(new chunk(*c));
+        (*c)[i & mask()] = value;
+      } else {
+        v = value;
+      }
+    }
+
+    // The number of chunks that are not shared with another fork, or
+    // within this map
+    std::size_t num_owned_chunks() const
+    {
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < m_chunks->size(); ++i) {
+        if ((*m_chunks)[i].use_count() == 1) {
+          ++n;
+        }
+      }
+      return n;
+    }
+
+    std::size_t num_chunks() const
+    {
+      return m_chunks->size();
+    }
+
+    // Friends, so that they are only found by argument dependent lookup 
+    // and do not hide boost::get and boost::put inside namespace blink.
+    friend T get(const cow_vector_property_map& pm, const key_type& key)
+    {
+      return pm.get(key);
+    }
+
+    friend void put(const cow_vector_property_map& pm, const key_type& key,
+      const T& value)
+    {
+      pm.put(key, value);
+    }
+
+  private:
+    typedef std::vector<T> chunk;
+    typedef std::vector<boost::shared_ptr<chunk> > chunk_vector;
+
+    static std::size_t chunk_size()
+    {
+      return std::size_t(1) << chunk_bits;
+    }
+
+    static std::size_t mask()
+    {
+      return chunk_size() - 1;
+    }
+
+    static std::size_t num_chunks(std::size_t n)
+    {
+      return (n + chunk_size() - 1) >> chunk_bits;
+    }
+
+    boost::shared_ptr<chunk_vector> m_chunks;
+    IndexMap m_index;
+  };
+
+  template<typename T, typename IndexMap>
+  cow_vector_property_map<T, IndexMap> make_cow_vector_property_map(
+    std::size_t n, IndexMap index, const T& initial = T())
+  {
+    return cow_vector_property_map<T, IndexMap>(n, index, initial);
+  }
+
+  // fork_property_map is used by fork_dijkstra for the vertex maps of the
+  // search. Without a graph it is only defined for the maps that can be
+  // forked in O(1) per chunk.
+  template<typename T, typename IndexMap>
+  cow_vector_property_map<T, IndexMap> fork_property_map(
+    const cow_vector_property_map<T, IndexMap>& pm)
+  {
+    return pm.fork();
+  }
+
+  template<typename Key, typename Value>
+  boost::null_property_map<Key, Value> fork_property_map(
+    const boost::null_property_map<Key, Value>& pm)
+  {
+    return pm;
+  }
+
+  template<typename T, typename IndexMap, typename Graph, 
+    typename VertexIndexMap>
+  cow_vector_property_map<T, IndexMap> fork_property_map(
+    const cow_vector_property_map<T, IndexMap>& pm, const Graph&, 
+    VertexIndexMap)
+  {
+    return pm.fork();
+  }
+
+  template<typename Key, typename Value, typename Graph, 
+    typename VertexIndexMap>
+  boost::null_property_map<Key, Value> fork_property_map(
+    const boost::null_property_map<Key, Value>& pm, const Graph&, 
+    VertexIndexMap)
+  {
+    return pm;
+  }
+
+  // Fallback that copies all values, in O(V). Requires that the map can be
+  // made as PropertyMap(num_vertices(g), index), as the default maps of 
+  // the searches (shared_array_property_map, two_bit_color_map and 
+  // vector_property_map).
+  template<typename PropertyMap, typename Graph, typename VertexIndexMap>
+  PropertyMap fork_property_map(const PropertyMap& pm, const Graph& g, 
+    VertexIndexMap index)
+  {
+    PropertyMap copy(num_vertices(g), index);
+    BGL_FORALL_VERTICES_T(v, g, Graph) {
+      put(copy, v, get(pm, v));
+    }
+    return copy;
+  }
+}//namespace blink
+
+#endif // BLINK_COW_VECTOR_PROPERTY_MAP_HPP
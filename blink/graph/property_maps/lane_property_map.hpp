@@ -0,0 +1,73 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The lane_property_map gives access to one element (lane) of a property
+// map whose values are fixed size arrays, for instance the distances of
+// one search in a multi-lane search.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_LANE_PROPERTY_MAP_HPP
+#define BLINK_LANE_PROPERTY_MAP_HPP
+
+#include <boost/property_map/property_map.hpp>
+
+#include <cstddef>
+
+namespace blink
+{
+  template<typename ArrayMap>
+  struct lane_property_map
+  {
+    typedef typename boost::property_traits<ArrayMap>::key_type key_type;
+    typedef typename boost::property_traits<ArrayMap>::value_type array_type;
+    typedef typename array_type::value_type value_type;
+    typedef value_type reference;
+    typedef boost::read_write_property_map_tag category;
+
+    lane_property_map() : m_lane(0)
+    {}
+
+    lane_property_map(ArrayMap map, std::size_t lane)
+      : m_map(map), m_lane(lane)
+    {}
+
+    // Hidden friends, templates at namespace scope would hide boost::put
+    // for pointer maps in unqualified calls inside namespace blink
+    friend value_type get(const lane_property_map& pm, const key_type& key)
+    {
+      using boost::get;
+      return get(pm.m_map, key)[pm.m_lane];
+    }
+
+    friend void put(const lane_property_map& pm, const key_type& key,
+      const value_type& value)
+    {
+      using boost::get;
+      using boost::put;
+      array_type a = get(pm.m_map, key);
+      a[pm.m_lane] = value;
+      put(pm.m_map, key, a);
+    }
+
+    ArrayMap m_map;
+    std::size_t m_lane;
+  };
+
+  template<typename ArrayMap>
+  lane_property_map<ArrayMap> make_lane_property_map(ArrayMap map,
+    std::size_t lane)
+  {
+    return lane_property_map<ArrayMap>(map, lane);
+  }
+}//namespace blink
+
+#endif // BLINK_LANE_PROPERTY_MAP_HPP
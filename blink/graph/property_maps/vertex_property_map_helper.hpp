@@ -46,7 +46,7 @@ namespace blink
     
     static sized_map make(const Graph& g, VertexIndexMap index, boost::true_type)
 	  {
-		  return sized_map(boost::num_vertices(g), index);
+		  return sized_map(num_vertices(g), index);
 	  }
 	  static unsized_map make(const Graph& g, VertexIndexMap index, boost::false_type)
 	  {
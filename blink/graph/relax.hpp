@@ -11,7 +11,7 @@
 // Two specialized relax functions that, when appropriate, are more efficient
 // than the boost relax function. relax_target (skips relaxing the origin 
 // of a vertex). relax_target_confident (assumes that the target distance 
-// decreases).
+// decreases). relax_lanes relaxes the distances of several searches at once.
 //
 // This file can be deprecated once the following patch is applied:
 // https://svn.boost.org/trac/boost/ticket/7387
@@ -20,6 +20,7 @@
 #ifndef BLINK_GRAPH_RELAX_HPP
 #define BLINK_GRAPH_RELAX_HPP
 
+#include <cstddef>
 #include <functional>
 
 #include <boost/limits.hpp> // for numeric limits
@@ -77,6 +78,33 @@ template <class Graph, class WeightMap,
     put(p, v, u);
   }
 
+  // Relax all lanes of a fixed size array of distances (one lane per search)
+  // over an edge of weight w_e. Lanes where d_u is inf are skipped. Returns 
+  // true if any lane of d_v decreased, min_decreased is lowered to the 
+  // smallest decreased distance. The loop has no dependencies between lanes,
+  // so that it can be vectorized.
+  template <class Lanes, class Weight, class BinaryFunction, 
+    class BinaryPredicate, class Distance>
+  bool relax_lanes(const Lanes& d_u, Lanes& d_v, const Weight& w_e, 
+    const BinaryFunction& combine, const BinaryPredicate& compare,
+    const Distance& inf, Distance& min_decreased)
+  {
+    bool decreased = false;
+    for (std::size_t k = 0; k < d_u.size(); ++k) {
+      if (compare(d_u[k], inf)) {
+        const Distance d = combine(d_u[k], w_e);
+        if (compare(d, d_v[k])) {
+          d_v[k] = d;
+          decreased = true;
+          if (compare(d, min_decreased)) {
+            min_decreased = d;
+          }
+        }
+      }
+    }
+    return decreased;
+  }
+
 } // namespace blink
 
 #endif // BLINK_GRAPH_RELAX_HPP
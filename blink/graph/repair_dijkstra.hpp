@@ -0,0 +1,223 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// repair updates a completed resumable_dijkstra after the weights of some
+// edges were modified in its weight map. Only the affected vertices are 
+// reopened, see reopen_edges, and expanded again with the reopen visitor.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_REPAIR_DIJKSTRA_HPP
+#define BLINK_GRAPH_REPAIR_DIJKSTRA_HPP
+
+#include <blink/graph/breadth_first_search.hpp> // default_interruptor
+#include <blink/graph/dijkstra_visitor/joined_visitor.hpp>
+#include <blink/graph/dijkstra_visitor/reopen_visitor.hpp>
+#include <blink/graph/resumable_dijkstra.hpp>
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/named_function_params.hpp>
+#include <boost/graph/properties.hpp> // color_traits
+#include <boost/property_map/property_map.hpp>
+#include <boost/range.hpp>
+#include <boost/tuple/tuple.hpp> // tie
+
+#include <cstddef>
+#include <vector>
+
+namespace blink {
+
+// The reopen_visitor type of a search
+template<typename DijkstraState>
+struct reopen_visitor_helper
+{
+  typedef reopen_visitor
+    < typename DijkstraState::template param<boost::max_priority_queue_t>::type
+    , typename DijkstraState::template param<boost::edge_weight_t>::type
+    , typename DijkstraState::template param<boost::vertex_distance_t>::type
+    , typename DijkstraState::template param<boost::vertex_color_t>::type
+    , typename DijkstraState::template param<boost::distance_combine_t>::type
+    , typename DijkstraState::template param<boost::distance_compare_t>::type
+    > type;
+};
+
+// To expand a reopened search with other interruptors or visitors
+template<typename DijkstraState>
+typename reopen_visitor_helper<DijkstraState>::type make_reopen_visitor(
+  resumable_dijkstra<DijkstraState>& dijkstra)
+{
+  return typename reopen_visitor_helper<DijkstraState>::type(
+    dijkstra.get(boost::max_priority_queue_t()), 
+    dijkstra.get(boost::edge_weight_t()), 
+    dijkstra.get(boost::vertex_distance_t()), 
+    dijkstra.get(boost::vertex_color_t()), 
+    dijkstra.get(boost::distance_combine_t()), 
+    dijkstra.get(boost::distance_compare_t()));
+}
+
+namespace detail {
+
+// Reset root and all vertices below it in the shortest path tree, 
+// appending them to reset.
+template<typename DijkstraState, typename Vertex>
+void reset_subtree(resumable_dijkstra<DijkstraState>& dijkstra, Vertex root,
+  std::vector<Vertex>& reset)
+{
+  typedef typename DijkstraState::graph_type graph_type;
+  typedef typename DijkstraState::template param<boost::vertex_color_t>
+    ::type color_map_type;
+  typedef boost::color_traits<typename boost::property_traits<
+    color_map_type>::value_type> color_traits;
+
+  const graph_type& g = dijkstra.get_graph();
+  color_map_type& color = dijkstra.get(boost::vertex_color_t());
+  typename DijkstraState::template param<boost::vertex_distance_t>::type& 
+    distance = dijkstra.get(boost::vertex_distance_t());
+  typename DijkstraState::template param<boost::vertex_predecessor_t>::type& 
+    predecessor = dijkstra.get(boost::vertex_predecessor_t());
+
+  const std::size_t first = reset.size();
+  reset.push_back(root);
+  for (std::size_t i = first; i < reset.size(); ++i) {
+    const Vertex u = reset[i];
+    put(color, u, color_traits::white());
+    put(distance, u, dijkstra.get(boost::distance_inf_t()));
+    put(predecessor, u, u);
+    typename boost::graph_traits<graph_type>::out_edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = out_edges(u, g); ei != ei_end; ++ei) {
+      const Vertex v = target(*ei, g);
+      if (v != u && get(color, v) != color_traits::white()
+        && get(predecessor, v) == u) {
+        put(color, v, color_traits::white());
+        reset.push_back(v);
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+// Reopen a completed search for the changed edges, without expanding it.
+// Requires a predecessor map and in_edges (a bidirectional graph).
+// - If a shortest path tree edge became longer, the subtree below it is 
+//   reset to white and its vertices are queued again with the best 
+//   distance over in-edges from the rest of the tree.
+// - If an edge became shorter, its target is queued with the new 
+//   distance.
+// The following expansion must use the reopen visitor (see repair), to 
+// reopen black vertices that become closer. 
+template<typename DijkstraState, typename EdgeRange>
+void reopen_edges(resumable_dijkstra<DijkstraState>& dijkstra, 
+  const EdgeRange& changed)
+{
+  typedef typename DijkstraState::graph_type graph_type;
+  typedef boost::graph_traits<graph_type> graph_traits;
+  typedef typename graph_traits::vertex_descriptor vertex_descriptor;
+  typedef typename DijkstraState::template param<boost::vertex_color_t>
+    ::type color_map_type;
+  typedef typename boost::property_traits<color_map_type>::value_type 
+    color_type;
+  typedef boost::color_traits<color_type> color_traits;
+  typedef typename DijkstraState::template param<boost::vertex_distance_t>
+    ::type distance_map_type;
+  typedef typename boost::property_traits<distance_map_type>::value_type 
+    distance_type;
+  typedef typename boost::range_iterator<const EdgeRange>::type iterator;
+
+  const graph_type& g = dijkstra.get_graph();
+  color_map_type& color = dijkstra.get(boost::vertex_color_t());
+  distance_map_type& distance = dijkstra.get(boost::vertex_distance_t());
+  typename DijkstraState::template param<boost::vertex_predecessor_t>::type& 
+    predecessor = dijkstra.get(boost::vertex_predecessor_t());
+  typename DijkstraState::template param<boost::edge_weight_t>::type& 
+    weight = dijkstra.get(boost::edge_weight_t());
+  typename DijkstraState::template param<boost::distance_compare_t>::type& 
+    compare = dijkstra.get(boost::distance_compare_t());
+  typename DijkstraState::template param<boost::distance_combine_t>::type& 
+    combine = dijkstra.get(boost::distance_combine_t());
+  typename DijkstraState::template param<boost::max_priority_queue_t>::type&
+    queue = dijkstra.get(boost::max_priority_queue_t());
+
+  std::vector<vertex_descriptor> reset;
+  for (iterator i = boost::begin(changed); i != boost::end(changed); ++i) {
+    const vertex_descriptor u = source(*i, g);
+    const vertex_descriptor v = target(*i, g);
+    if (u != v && get(color, u) != color_traits::white()
+      && get(color, v) != color_traits::white()
+      && get(predecessor, v) == u
+      && compare(get(distance, v), combine(get(distance, u), 
+        get(weight, *i)))) {
+      detail::reset_subtree(dijkstra, v, reset);
+    }
+  }
+
+  for (std::size_t i = 0; i < reset.size(); ++i) {
+    const vertex_descriptor v = reset[i];
+    typename graph_traits::in_edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = in_edges(v, g); ei != ei_end; ++ei) {
+      const vertex_descriptor u = source(*ei, g);
+      if (get(color, u) == color_traits::black()) {
+        const distance_type d = combine(get(distance, u), get(weight, *ei));
+        if (compare(d, get(distance, v))) {
+          put(distance, v, d);
+          put(predecessor, v, u);
+        }
+      }
+    }
+    if (compare(get(distance, v), dijkstra.get(boost::distance_inf_t()))) {
+      put(color, v, color_traits::gray());
+      queue.push(v);
+    }
+  }
+
+  for (iterator i = boost::begin(changed); i != boost::end(changed); ++i) {
+    const vertex_descriptor u = source(*i, g);
+    const vertex_descriptor v = target(*i, g);
+    if (get(color, u) == color_traits::white()) {
+      continue;
+    }
+    const distance_type d = combine(get(distance, u), get(weight, *i));
+    const color_type c = get(color, v);
+    if (c == color_traits::white() || compare(d, get(distance, v))) {
+      put(distance, v, d);
+      put(predecessor, v, u);
+      if (c == color_traits::gray()) {
+        queue.update(v);
+      } else {
+        put(color, v, color_traits::gray());
+        queue.push(v);
+      }
+    }
+  }
+}
+
+// Repair a completed search after the weights of the changed edges were
+// modified in the weight map, applying the SecondVisitor while expanding.
+template<typename DijkstraState, typename EdgeRange, typename SecondVisitor>
+void repair(resumable_dijkstra<DijkstraState>& dijkstra, 
+  const EdgeRange& changed, SecondVisitor vis)
+{
+  reopen_edges(dijkstra, changed);
+  dijkstra.expand(default_interruptor(), make_joined_visitor(
+    make_reopen_visitor(dijkstra), vis));
+}
+
+template<typename DijkstraState, typename EdgeRange>
+void repair(resumable_dijkstra<DijkstraState>& dijkstra, 
+  const EdgeRange& changed)
+{
+  repair(dijkstra, changed, boost::default_dijkstra_visitor());
+}
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_REPAIR_DIJKSTRA_HPP
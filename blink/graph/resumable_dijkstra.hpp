@@ -31,9 +31,46 @@ namespace blink {
 template<typename DijkstraState>
 class resumable_dijkstra : public dijkstra_state_mixin<DijkstraState>
 {
+  typedef dijkstra_state_mixin<DijkstraState> mixin;
+  typedef typename mixin::graph_type graph_type;
+  typedef typename mixin::distance_combine_type distance_combine_type;
+  typedef typename mixin::distance_compare_type distance_compare_type;
+  typedef typename mixin::distance_inf_type distance_inf_type;
+  typedef typename mixin::distance_zero_type distance_zero_type;
+  typedef typename mixin::edge_weight_type edge_weight_type;
+  typedef typename mixin::max_priority_queue_type max_priority_queue_type;
+  typedef typename mixin::vertex_color_type vertex_color_type;
+  typedef typename mixin::vertex_distance_type vertex_distance_type;
+  typedef typename mixin::vertex_index_type vertex_index_type;
+  typedef typename mixin::vertex_predecessor_type vertex_predecessor_type;
+  typedef typename mixin::graph_visitor_type graph_visitor_type;
+  typedef typename mixin::graph_traits graph_traits;
+  typedef typename mixin::vertex_descriptor vertex_descriptor;
+  typedef typename mixin::vertex_iterator vertex_iterator;
+  typedef typename mixin::edge_descriptor edge_descriptor;
+  typedef typename mixin::out_edge_iterator out_edge_iterator;
+  typedef typename mixin::distance_type distance_type;
+  typedef typename mixin::color_type color_type;
+  typedef typename mixin::color_traits color_traits;
+
+  using mixin::m_graph;
+  using mixin::m_distance_combine;
+  using mixin::m_distance_compare;
+  using mixin::m_distance_inf;
+  using mixin::m_distance_zero;
+  using mixin::m_edge_weight;
+  using mixin::m_graph_visitor;
+  using mixin::m_max_priority_queue;
+  using mixin::m_vertex_color;
+  using mixin::m_vertex_distance;
+  using mixin::m_vertex_index;
+  using mixin::m_vertex_predecessor;
+
 public:
+  using mixin::get;
+
   resumable_dijkstra(const DijkstraState& state) 
-    : dijkstra_state_mixin(boost::shared_ptr<DijkstraState>(new DijkstraState(state) ) )
+    : mixin(boost::shared_ptr<DijkstraState>(new DijkstraState(state) ) )
   {}
        
   // Expand the shortest path search until the Interruptor returns true on
@@ -111,8 +148,8 @@ public:
   template<typename VerticesRange, typename SecondVisitor>
   void put_sources(const VerticesRange& r, SecondVisitor vis) 
   {
-    boost::range_iterator<const VerticesRange>::type i = boost::begin(r);
-    const boost::range_iterator<const VerticesRange>::type end = boost::end(r);
+    typename boost::range_iterator<const VerticesRange>::type i = boost::begin(r);
+    const typename boost::range_iterator<const VerticesRange>::type end = boost::end(r);
     for(; i != end; ++i) {
       put_source(*i, vis);
     }
@@ -158,14 +195,14 @@ template<typename Graph, typename Params>
 struct resumable_dijkstra_helper 
   : protected dijkstra_state_helper<Graph, Params>
 {
-  typedef typename dijkstra_state_helper<Graph, Params> parent;
+  typedef dijkstra_state_helper<Graph, Params> parent;
   typedef typename parent::type state_type;
 
   template<typename Tag>
-  struct param : parent::param<Tag>
+  struct param : parent::template param<Tag>
   {};
 
-  typedef typename resumable_dijkstra<state_type> type;
+  typedef resumable_dijkstra<state_type> type;
 
   static type make(const Graph& g, const Params& params)
   {
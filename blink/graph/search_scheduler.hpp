@@ -0,0 +1,446 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// The search_scheduler multiplexes many resumable searches onto a fixed
+// set of worker threads. Each search is expanded in time slices, using a
+// deadline_interruptor, until its goal interrupts it or its queue is
+// empty. Then its done callback is called on the worker thread.
+//
+// Ready searches are run by highest priority, then earliest deadline,
+// then round-robin. Strict priorities can starve lower priorities.
+// Searches can be suspended, for instance while their consumer is behind,
+// and resumed, from any thread including from the visitors of the search.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_SEARCH_SCHEDULER_HPP
+#define BLINK_GRAPH_SEARCH_SCHEDULER_HPP
+
+#include <blink/graph/breadth_first_search.hpp> // default_interruptor, either_interruptor
+#include <blink/graph/deadline_interruptor.hpp>
+#include <blink/graph/dijkstra_visitor/joined_visitor.hpp>
+#include <blink/graph/dijkstra_visitor/statistics_visitor.hpp>
+#include <blink/graph/thread_pool.hpp> // default_size
+
+#include <boost/graph/dijkstra_shortest_paths.hpp> // default_dijkstra_visitor
+#include <boost/graph/properties.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace blink {
+
+// A goal for searches that run until their queue is empty
+struct exhaustive_search_goal
+  : public boost::default_dijkstra_visitor, public default_interruptor
+{};
+
+struct search_scheduler_statistics
+{
+  typedef std::chrono::steady_clock::duration duration;
+
+  search_scheduler_statistics()
+    : submitted(0), completed(0), cancelled(0), failed(0)
+    , deadlines_missed(0), slices(0), vertices_settled(0), edges_scanned(0)
+    , busy_time(duration::zero()), elapsed(duration::zero())
+    , total_latency(duration::zero()), max_latency(duration::zero())
+  {}
+
+  // completed searches per second
+  double throughput() const
+  {
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0 ? completed / seconds : 0.0;
+  }
+
+  duration mean_latency() const
+  {
+    if (completed == 0) {
+      return duration::zero();
+    }
+    return total_latency / static_cast<duration::rep>(completed);
+  }
+
+  std::size_t submitted;
+  std::size_t completed;
+  std::size_t cancelled;
+  std::size_t failed;           // threw an exception
+  std::size_t deadlines_missed; // completed after their deadline
+  std::size_t slices;
+  std::size_t vertices_settled;
+  std::size_t edges_scanned;
+  duration busy_time;           // summed over all workers
+  duration elapsed;             // since the scheduler was constructed
+  duration total_latency;       // from submit to completion
+  duration max_latency;
+};
+
+namespace detail {
+
+class scheduled_search
+{
+public:
+  virtual ~scheduled_search()
+  {}
+
+  // Expand for one slice, returns true if the search is finished
+  virtual bool run_slice(deadline_interruptor& deadline,
+    std::size_t& vertices_settled, std::size_t& edges_scanned) = 0;
+
+  virtual void done() = 0;
+};
+
+template<typename Dijkstra, typename Goal, typename Done>
+class scheduled_search_impl : public scheduled_search
+{
+public:
+  scheduled_search_impl(const Dijkstra& dijkstra, Goal goal, Done done)
+    : m_dijkstra(dijkstra), m_goal(goal), m_done(done)
+  {}
+
+  bool run_slice(deadline_interruptor& deadline,
+    std::size_t& vertices_settled, std::size_t& edges_scanned)
+  {
+    typedef either_interruptor<deadline_interruptor, Goal> interruptor_type;
+
+    interruptor_type interruptor(deadline, m_goal);
+    const statistics_visitor<typename Dijkstra::template param<
+      boost::max_priority_queue_t>::type, typename Dijkstra::template param<
+      boost::vertex_distance_t>::type> statistics
+      = make_statistics_visitor(m_dijkstra.get(boost::max_priority_queue_t()),
+        m_dijkstra.get(boost::vertex_distance_t()),
+        m_dijkstra.get(boost::distance_zero_t()));
+    const bool empty = m_dijkstra.expand(interruptor,
+      make_joined_visitor(m_goal, statistics));
+
+    vertices_settled = statistics.statistics().vertices_settled;
+    edges_scanned = statistics.statistics().edges_scanned;
+    return empty || m_goal.do_interrupt();
+  }
+
+  void done()
+  {
+    m_done(m_dijkstra);
+  }
+
+private:
+  Dijkstra m_dijkstra;
+  Goal m_goal;
+  Done m_done;
+};
+
+} // namespace detail
+
+class search_scheduler : boost::noncopyable
+{
+public:
+  typedef std::size_t search_id;
+  typedef std::chrono::steady_clock clock_type;
+  typedef clock_type::duration duration;
+  typedef clock_type::time_point time_point;
+
+  explicit search_scheduler(std::size_t num_threads
+    = thread_pool::default_size(),
+    duration slice = std::chrono::microseconds(200))
+    : m_slice(slice), m_next_id(0), m_next_sequence(0), m_running(0)
+    , m_stop(false), m_start(clock_type::now())
+  {
+    if (num_threads == 0) {
+      num_threads = 1;
+    }
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      m_threads.push_back(std::thread(&search_scheduler::work, this));
+    }
+  }
+
+  // Finishes the running slices, unfinished searches are dropped
+  ~search_scheduler()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_work_cv.notify_all();
+    for (std::size_t i = 0; i < m_threads.size(); ++i) {
+      m_threads[i].join();
+    }
+  }
+
+  // Schedule a search that was initialized, for instance with
+  // init_from_source. The Goal is a visitor and interruptor, such as
+  // distance_visitor. Done is called as done(dijkstra) when the goal
+  // interrupts or the queue is empty.
+  template<typename Dijkstra, typename Goal, typename Done>
+  search_id submit(const Dijkstra& dijkstra, Goal goal, Done done,
+    int priority = 0, time_point deadline = time_point::max())
+  {
+    typedef detail::scheduled_search_impl<Dijkstra, Goal, Done> impl_type;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const search_id id = m_next_id++;
+    entry& e = m_searches[id];
+    e.search.reset(new impl_type(dijkstra, goal, done));
+    e.priority = priority;
+    e.deadline = deadline;
+    e.submitted = clock_type::now();
+    ++m_statistics.submitted;
+    make_ready(id, e);
+    lock.unlock();
+    m_work_cv.notify_one();
+    return id;
+  }
+
+  // Stop scheduling the search after its current slice. Returns false if
+  // the search is finished.
+  bool suspend(search_id id)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    searches_type::iterator i = m_searches.find(id);
+    if (i == m_searches.end()) {
+      return false;
+    }
+    entry& e = i->second;
+    if (e.status == ready) {
+      m_ready.erase(e.key);
+      e.status = suspended;
+      m_done_cv.notify_all();
+    } else if (e.status == running) {
+      e.suspend = true;
+    }
+    return true;
+  }
+
+  bool resume(search_id id)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    searches_type::iterator i = m_searches.find(id);
+    if (i == m_searches.end()) {
+      return false;
+    }
+    entry& e = i->second;
+    e.suspend = false;
+    if (e.status == suspended) {
+      make_ready(id, e);
+      lock.unlock();
+      m_work_cv.notify_one();
+    }
+    return true;
+  }
+
+  // Remove the search without calling done, a running search is removed
+  // after its current slice. Returns false if the search is finished.
+  bool cancel(search_id id)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    searches_type::iterator i = m_searches.find(id);
+    if (i == m_searches.end()) {
+      return false;
+    }
+    if (i->second.status == running) {
+      i->second.cancel = true;
+    } else {
+      if (i->second.status == ready) {
+        m_ready.erase(i->second.key);
+      }
+      m_searches.erase(i);
+      ++m_statistics.cancelled;
+      m_done_cv.notify_all();
+    }
+    return true;
+  }
+
+  // Block until no search is ready or running, suspended searches are not
+  // waited for. Rethrows the first exception that escaped from a search.
+  // Must not be called from a worker.
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_ready.empty() || m_running != 0) {
+      m_done_cv.wait(lock);
+    }
+    if (m_exception) {
+      std::exception_ptr e = m_exception;
+      m_exception = std::exception_ptr();
+      std::rethrow_exception(e);
+    }
+  }
+
+  // The number of searches that are not finished, including suspended
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_searches.size();
+  }
+
+  std::size_t num_threads() const
+  {
+    return m_threads.size();
+  }
+
+  search_scheduler_statistics statistics() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    search_scheduler_statistics s = m_statistics;
+    s.elapsed = clock_type::now() - m_start;
+    return s;
+  }
+
+private:
+  enum status_type { ready, running, suspended };
+
+  struct ready_key
+  {
+    bool operator<(const ready_key& other) const
+    {
+      if (priority != other.priority) {
+        return priority > other.priority;
+      }
+      if (deadline != other.deadline) {
+        return deadline < other.deadline;
+      }
+      return sequence < other.sequence;
+    }
+
+    int priority;
+    time_point deadline;
+    std::size_t sequence;
+    search_id id;
+  };
+
+  struct entry
+  {
+    entry() : status(ready), suspend(false), cancel(false)
+    {}
+
+    boost::shared_ptr<detail::scheduled_search> search;
+    int priority;
+    time_point deadline;
+    time_point submitted;
+    ready_key key;
+    status_type status;
+    bool suspend;
+    bool cancel;
+  };
+
+  typedef std::unordered_map<search_id, entry> searches_type;
+
+  // requires lock
+  void make_ready(search_id id, entry& e)
+  {
+    e.status = ready;
+    e.key.priority = e.priority;
+    e.key.deadline = e.deadline;
+    e.key.sequence = m_next_sequence++;
+    e.key.id = id;
+    m_ready.insert(e.key);
+  }
+
+  void work()
+  {
+    deadline_interruptor deadline(m_slice);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      while (m_ready.empty() && !m_stop) {
+        m_work_cv.wait(lock);
+      }
+      if (m_stop) {
+        return;
+      }
+      const search_id id = m_ready.begin()->id;
+      m_ready.erase(m_ready.begin());
+      entry& e = m_searches[id];
+      e.status = running;
+      ++m_running;
+      boost::shared_ptr<detail::scheduled_search> search = e.search;
+      lock.unlock();
+
+      const time_point start = clock_type::now();
+      std::size_t settled = 0;
+      std::size_t scanned = 0;
+      bool finished = false;
+      bool failed = false;
+      try {
+        deadline.restart();
+        finished = search->run_slice(deadline, settled, scanned);
+        if (finished) {
+          search->done();
+        }
+      } catch (...) {
+        failed = true;
+        std::lock_guard<std::mutex> exception_lock(m_mutex);
+        if (!m_exception) {
+          m_exception = std::current_exception();
+        }
+      }
+      const time_point end = clock_type::now();
+
+      lock.lock();
+      ++m_statistics.slices;
+      m_statistics.vertices_settled += settled;
+      m_statistics.edges_scanned += scanned;
+      m_statistics.busy_time += end - start;
+      --m_running;
+      entry& f = m_searches[id];
+      if (failed) {
+        ++m_statistics.failed;
+        m_searches.erase(id);
+      } else if (finished) {
+        const duration latency = end - f.submitted;
+        ++m_statistics.completed;
+        m_statistics.total_latency += latency;
+        if (latency > m_statistics.max_latency) {
+          m_statistics.max_latency = latency;
+        }
+        if (end > f.deadline) {
+          ++m_statistics.deadlines_missed;
+        }
+        m_searches.erase(id);
+      } else if (f.cancel) {
+        ++m_statistics.cancelled;
+        m_searches.erase(id);
+      } else if (f.suspend) {
+        f.suspend = false;
+        f.status = suspended;
+      } else {
+        make_ready(id, f);
+      }
+      m_done_cv.notify_all();
+    }
+  }
+
+  duration m_slice;
+  std::vector<std::thread> m_threads;
+  mutable std::mutex m_mutex; // guards everything below
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  searches_type m_searches;
+  std::set<ready_key> m_ready;
+  search_id m_next_id;
+  std::size_t m_next_sequence;
+  std::size_t m_running;
+  bool m_stop;
+  time_point m_start;
+  search_scheduler_statistics m_statistics;
+  std::exception_ptr m_exception;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_SEARCH_SCHEDULER_HPP
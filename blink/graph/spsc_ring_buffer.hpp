@@ -0,0 +1,109 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// A bounded lock-free ring buffer for one producer thread and one consumer
+// thread. try_push and try_pop never block, they return false when the
+// buffer is full or empty. The capacity is rounded up to a power of two.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_SPSC_RING_BUFFER_HPP
+#define BLINK_GRAPH_SPSC_RING_BUFFER_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace blink {
+
+template<typename T>
+class spsc_ring_buffer : boost::noncopyable
+{
+public:
+  explicit spsc_ring_buffer(std::size_t capacity)
+    : m_buffer(round_up(capacity)), m_mask(m_buffer.size() - 1)
+    , m_head(0), m_cached_tail(0), m_tail(0), m_cached_head(0)
+  {}
+
+  std::size_t capacity() const
+  {
+    return m_buffer.size();
+  }
+
+  // Producer only
+  bool try_push(const T& value)
+  {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cached_head == m_buffer.size()) {
+      m_cached_head = m_head.load(std::memory_order_acquire);
+      if (tail - m_cached_head == m_buffer.size()) {
+        return false;
+      }
+    }
+    m_buffer[tail & m_mask] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only
+  bool try_pop(T& value)
+  {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cached_tail) {
+      m_cached_tail = m_tail.load(std::memory_order_acquire);
+      if (head == m_cached_tail) {
+        return false;
+      }
+    }
+    value = m_buffer[head & m_mask];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Exact when called by the producer or consumer while the other is idle
+  std::size_t size() const
+  {
+    return m_tail.load(std::memory_order_acquire)
+      - m_head.load(std::memory_order_acquire);
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+private:
+  static std::size_t round_up(std::size_t n)
+  {
+    std::size_t p = 2;
+    while (p < n) {
+      p *= 2;
+    }
+    return p;
+  }
+
+  std::vector<T> m_buffer;
+  const std::size_t m_mask;
+
+  // The consumer and producer indices on their own cache lines, each with
+  // the other side's index as last seen, so that the shared line is only
+  // read when the buffer seems empty or full.
+  alignas(64) std::atomic<std::size_t> m_head;
+  std::size_t m_cached_tail;
+  alignas(64) std::atomic<std::size_t> m_tail;
+  std::size_t m_cached_head;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_SPSC_RING_BUFFER_HPP
@@ -0,0 +1,217 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// A small work-stealing thread pool. Every worker has its own task deque,
+// it takes work from the back of its own deque and steals from the front
+// of the others when it runs out. Tasks posted from a worker go to that
+// worker's deque, tasks posted from elsewhere are dealt round-robin.
+//
+//=======================================================================
+//
+
+#ifndef BLINK_GRAPH_THREAD_POOL_HPP
+#define BLINK_GRAPH_THREAD_POOL_HPP
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace blink {
+
+class thread_pool : boost::noncopyable
+{
+public:
+  typedef std::function<void()> task_type;
+
+  static const std::size_t not_a_worker = std::size_t(-1);
+
+  explicit thread_pool(std::size_t num_threads = default_size())
+    : m_queues(num_threads == 0 ? 1 : num_threads)
+    , m_queued(0), m_unfinished(0), m_next(0), m_stop(false)
+  {
+    for (std::size_t i = 0; i < m_queues.size(); ++i) {
+      m_queues[i].reset(new worker_queue);
+    }
+    for (std::size_t i = 0; i < m_queues.size(); ++i) {
+      m_threads.push_back(std::thread(&thread_pool::work, this, i));
+    }
+  }
+
+  // Finishes all tasks that were posted before stopping the workers
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_work_cv.notify_all();
+    for (std::size_t i = 0; i < m_threads.size(); ++i) {
+      m_threads[i].join();
+    }
+  }
+
+  static std::size_t default_size()
+  {
+    const std::size_t n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+  }
+
+  std::size_t size() const
+  {
+    return m_queues.size();
+  }
+
+  // The index of the calling thread in this pool, or not_a_worker
+  std::size_t current_worker() const
+  {
+    if (current_pool() != this) {
+      return not_a_worker;
+    }
+    return current_index();
+  }
+
+  template<typename Task>
+  void post(Task task)
+  {
+    std::size_t i = current_worker();
+    if (i == not_a_worker) {
+      i = m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+    m_unfinished.fetch_add(1);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      ++m_queued;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_queues[i]->mutex);
+      m_queues[i]->tasks.push_back(task_type(task));
+    }
+    m_work_cv.notify_one();
+  }
+
+  // Block until all posted tasks have finished. Rethrows the first
+  // exception that escaped from a task. Must not be called from a worker.
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_unfinished.load() != 0) {
+      m_done_cv.wait(lock);
+    }
+    if (m_exception) {
+      std::exception_ptr e = m_exception;
+      m_exception = std::exception_ptr();
+      std::rethrow_exception(e);
+    }
+  }
+
+private:
+  struct worker_queue
+  {
+    std::mutex mutex;
+    std::deque<task_type> tasks;
+  };
+
+  static const thread_pool*& current_pool()
+  {
+    static thread_local const thread_pool* pool = 0;
+    return pool;
+  }
+
+  static std::size_t& current_index()
+  {
+    static thread_local std::size_t index = not_a_worker;
+    return index;
+  }
+
+  bool pop_own(std::size_t i, task_type& task)
+  {
+    std::lock_guard<std::mutex> lock(m_queues[i]->mutex);
+    if (m_queues[i]->tasks.empty()) {
+      return false;
+    }
+    task.swap(m_queues[i]->tasks.back());
+    m_queues[i]->tasks.pop_back();
+    return true;
+  }
+
+  bool steal(std::size_t i, task_type& task)
+  {
+    for (std::size_t k = 1; k < m_queues.size(); ++k) {
+      worker_queue& victim = *m_queues[(i + k) % m_queues.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task.swap(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void work(std::size_t i)
+  {
+    current_pool() = this;
+    current_index() = i;
+    task_type task;
+    for (;;) {
+      if (pop_own(i, task) || steal(i, task)) {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          --m_queued;
+        }
+        try {
+          task();
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if (!m_exception) {
+            m_exception = std::current_exception();
+          }
+        }
+        task = task_type();
+        if (m_unfinished.fetch_sub(1) == 1) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_done_cv.notify_all();
+        }
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (m_queued == 0 && !m_stop) {
+        m_work_cv.wait(lock);
+      }
+      if (m_queued == 0 && m_stop) {
+        return;
+      }
+    }
+  }
+
+  std::vector<boost::shared_ptr<worker_queue> > m_queues;
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex; // guards m_queued, m_stop and m_exception
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  std::size_t m_queued;
+  std::atomic<std::size_t> m_unfinished;
+  std::atomic<std::size_t> m_next;
+  bool m_stop;
+  std::exception_ptr m_exception;
+};
+
+} // namespace blink
+
+#endif // BLINK_GRAPH_THREAD_POOL_HPP
@@ -15,8 +15,24 @@
 #include <blink/graph/resumable_dijkstra.hpp>
 #include <blink/graph/dijkstra_object.hpp>
 #include <blink/graph/dijkstra_functions.hpp>
+#include <blink/graph/counting_queue.hpp>
+#include <blink/graph/dijkstra_batch.hpp>
 #include <blink/graph/dijkstra_state.hpp>
+#include <blink/graph/dijkstra_state_io.hpp>
+#include <blink/graph/event_pipeline.hpp>
+#include <blink/graph/expand_async.hpp>
+#include <blink/graph/expand_for.hpp>
+#include <blink/graph/fork_dijkstra.hpp>
+#include <blink/graph/frontier_tracking_queue.hpp>
 #include <blink/graph/dijkstra_heap_wrapper.hpp>
+#include <blink/graph/deadline_interruptor.hpp>
+#include <blink/graph/dijkstra_search_cache.hpp>
+#include <blink/graph/many_to_many.hpp>
+#include <blink/graph/multi_lane_dijkstra.hpp>
+#include <blink/graph/repair_dijkstra.hpp>
+#include <blink/graph/search_scheduler.hpp>
+#include <blink/graph/dijkstra_visitor/composed_visitor.hpp>
+#include <blink/graph/dijkstra_visitor/counting_visitor.hpp>
 #include <blink/graph/dijkstra_visitor/distance_visitor.hpp>
 #include <blink/graph/dijkstra_visitor/joined_visitor.hpp>
 #include <blink/graph/dijkstra_visitor/logging_visitor.hpp>
@@ -28,8 +44,17 @@
 #include <boost/graph/properties.hpp>
 #include <boost/heap/d_ary_heap.hpp>
 #include <boost/ref.hpp>
+#include <boost/shared_ptr.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <functional> // less
+#include <future>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 template<typename Graph, typename DistanceMap, typename ColorMap>
@@ -293,6 +318,669 @@ void test_classic_blink(int n)
   report_progress(g, state.get<boost::vertex_distance_t>(), state.get<boost::vertex_color_t>());
 }
 
+void test_parallel_blink(int n)
+{
+  std::cout << "Test Parallel Blink" << std::endl;
+ 
+  graph_type g = make_a_simple_graph(n);
+  typedef blink::dijkstra_state_helper<graph_type, boost::no_named_parameters>::type state_type;
+  vertex_descriptor orig = 4;
+  std::size_t num_threads = 2;
+  double delta = 1.0;
+  state_type state = blink::dijkstra_shortest_path_plain_parallel(g, orig, num_threads, delta);
+
+  report_progress(g, state.get<boost::vertex_distance_t>(), state.get<boost::vertex_color_t>());
+}
+
+void test_batch_blink(int n)
+{
+  std::cout << "Test Batch Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  blink::thread_pool pool(2);
+
+  std::vector<std::pair<vertex_descriptor, double> > jobs;
+  for (int i = 0; i < n; ++i) {
+    jobs.push_back(std::make_pair(vertex_descriptor(i), 4.0));
+  }
+  std::vector<vertex_descriptor> columns;
+  columns.push_back(0);
+  columns.push_back(4);
+  std::vector<double> matrix(jobs.size() * columns.size());
+
+  blink::dijkstra_shortest_path_distance_batch(g, jobs, 
+    blink::make_distance_matrix_writer(columns, matrix.begin()), pool);
+
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    std::cout << jobs[i].first << ": " << matrix[i * 2] << " " 
+      << matrix[i * 2 + 1] << std::endl;
+  }
+}
+
+void test_multi_lane_blink(int n)
+{
+  std::cout << "Test Multi Lane Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  std::vector<vertex_descriptor> sources;
+  sources.push_back(0);
+  sources.push_back(4);
+  sources.push_back(7);
+
+  // Three searches in one pass, lane k is the search from sources[k]
+  auto dijkstra = blink::make_multi_lane_dijkstra<3>(g);
+  dijkstra.init_from_sources(sources);
+  dijkstra.expand();
+
+  std::cout << "Vertex" << '\t' << "From 0" << '\t' << "From 4" << '\t' 
+    << "From 7" << std::endl;
+  BGL_FORALL_VERTICES(v, g, graph_type) {
+    std::cout << v;
+    for (std::size_t lane = 0; lane < sources.size(); ++lane) {
+      std::cout << '\t' << get(dijkstra.get(boost::vertex_distance_t(), lane), v);
+    }
+    std::cout << std::endl;
+  }
+
+  // Each lane equals a single search
+  bool same = true;
+  for (std::size_t lane = 0; lane < sources.size(); ++lane) {
+    auto state = blink::dijkstra_shortest_path_plain(g, sources[lane]);
+    BGL_FORALL_VERTICES(v, g, graph_type) {
+      same = same && get(dijkstra.get(boost::vertex_distance_t(), lane), v) 
+        == get(state.get<boost::vertex_distance_t>(), v);
+    }
+  }
+  std::cout << "Lanes equal single searches: " << (same ? "yes" : "no") 
+    << std::endl << std::endl;
+}
+
+void test_search_cache_blink(int n)
+{
+  std::cout << "Test Search Cache Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+
+  // Room for two searches, the third source evicts the least recently used
+  const std::size_t per_search 
+    = blink::dijkstra_search_cache<graph_type>(g, 0).bytes_per_search();
+  blink::dijkstra_search_cache<graph_type> cache(g, 2 * per_search);
+  std::vector<vertex_descriptor> sources;
+  sources.push_back(0);
+  sources.push_back(4);
+  sources.push_back(0);
+  sources.push_back(7);
+  sources.push_back(4);
+
+  bool same = true;
+  for (std::size_t s = 0; s < sources.size(); ++s) {
+    auto state = blink::dijkstra_shortest_path_plain(g, sources[s]);
+    BGL_FORALL_VERTICES(v, g, graph_type) {
+      same = same && cache.distance(sources[s], v) 
+        == get(state.get<boost::vertex_distance_t>(), v);
+    }
+  }
+  const blink::dijkstra_search_cache_statistics& stats = cache.statistics();
+  std::cout << "Hits: " << stats.hits << " Resumes: " << stats.resumes
+    << " Misses: " << stats.misses << " Evictions: " << stats.evictions
+    << std::endl;
+  std::cout << "Cached distances equal single searches: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+void test_state_io_blink(int n)
+{
+  std::cout << "Test State IO Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  const vertex_descriptor orig = 4;
+
+  // Pause at distance 2 and write a snapshot
+  auto paused = blink::make_resumable_dijkstra(g);
+  paused.init_from_source(orig);
+  auto vis = blink::make_distance_visitor(paused.get_dijkstra_state(), 2.0);
+  paused.expand(vis, vis);
+  std::ostringstream os;
+  blink::save_state(paused.get_dijkstra_state(), os, blink::state_io_compact);
+  std::cout << "Snapshot of " << os.str().size() << " bytes" << std::endl;
+
+  // Resume it in a fresh search
+  auto resumed = blink::make_resumable_dijkstra(g);
+  std::istringstream is(os.str());
+  blink::load_state(resumed.get_dijkstra_state(), is);
+  resumed.expand();
+  report_progress(g, resumed.get(boost::vertex_distance_t()), 
+    resumed.get(boost::vertex_color_t()));
+
+  // A search that is not all white is refused
+  bool refused = false;
+  try {
+    std::istringstream again(os.str());
+    blink::load_state(resumed.get_dijkstra_state(), again);
+  } catch (const std::invalid_argument&) {
+    refused = true;
+  }
+  std::cout << "Loading into a used search refused: " 
+    << (refused ? "yes" : "no") << std::endl;
+
+  auto state = blink::dijkstra_shortest_path_plain(g, orig);
+  bool same = true;
+  BGL_FORALL_VERTICES(v, g, graph_type) {
+    same = same && get(resumed.get(boost::vertex_distance_t()), v) 
+      == get(state.get<boost::vertex_distance_t>(), v);
+  }
+  std::cout << "Resumed search equals single search: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+// Whether the distances of a search equal those of a single search from orig
+template<typename Dijkstra>
+bool equals_plain(const graph_type& g, Dijkstra& dijkstra, 
+  vertex_descriptor orig)
+{
+  auto state = blink::dijkstra_shortest_path_plain(g, orig);
+  bool same = true;
+  BGL_FORALL_VERTICES(v, g, graph_type) {
+    same = same && get(dijkstra.get(boost::vertex_distance_t()), v) 
+      == get(state.get<boost::vertex_distance_t>(), v);
+  }
+  return same;
+}
+
+void test_fork_blink(int n)
+{
+  std::cout << "Test Fork Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  const vertex_descriptor orig = 4;
+
+  // The forkable search shares its maps copy-on-write with the fork, the
+  // plain search has its maps copied
+  auto forkable = blink::make_forkable_dijkstra(g);
+  auto plain = blink::make_resumable_dijkstra(g);
+  forkable.init_from_source(orig);
+  plain.init_from_source(orig);
+  auto vis = blink::make_distance_visitor(forkable.get_dijkstra_state(), 2.0);
+  forkable.expand(vis, vis);
+  auto vis2 = blink::make_distance_visitor(plain.get_dijkstra_state(), 2.0);
+  plain.expand(vis2, vis2);
+
+  auto forkable_fork = blink::fork_dijkstra(forkable);
+  auto plain_fork = blink::fork_dijkstra(plain);
+
+  // Finishing the forks leaves the originals paused
+  forkable_fork.expand();
+  plain_fork.expand();
+  std::cout << "Paused after fork finished, distance at 9: " 
+    << get(forkable.get(boost::vertex_distance_t()), 9) << std::endl;
+  forkable.expand();
+  plain.expand();
+  report_progress(g, forkable_fork.get(boost::vertex_distance_t()), 
+    forkable_fork.get(boost::vertex_color_t()));
+
+  const bool same = equals_plain(g, forkable, orig) 
+    && equals_plain(g, forkable_fork, orig) && equals_plain(g, plain, orig) 
+    && equals_plain(g, plain_fork, orig);
+  std::cout << "Forks and originals equal single search: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+void test_frontier_blink(int n)
+{
+  std::cout << "Test Frontier Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  const vertex_descriptor orig = 4;
+  vertex_index_map_type index = get(boost::vertex_index, g);
+
+  // resumable_dijkstra: pause at distance 2, then continue the paused 
+  // search in a second search from its finished vertices and frontier
+  distance_map_type distance(n, index);
+  auto queue = blink::make_frontier_tracking_queue(g, distance, 
+    std::less<double>(), index);
+  auto dijkstra = blink::make_resumable_dijkstra(g, 
+    boost::distance_map(distance).max_priority_queue(queue));
+  dijkstra.init_from_source(orig);
+  auto vis = blink::make_distance_visitor(dijkstra.get_dijkstra_state(), 2.0);
+  dijkstra.expand(vis, vis);
+  auto frontier = blink::export_frontier(dijkstra);
+  std::cout << "Frontier at distance 2:";
+  for (std::size_t i = 0; i < frontier.size(); ++i) {
+    std::cout << ' ' << frontier[i].first << '(' << frontier[i].second << ')';
+  }
+  std::cout << std::endl;
+
+  auto imported = blink::make_resumable_dijkstra(g);
+  BGL_FORALL_VERTICES(v, g, graph_type) {
+    if (get(dijkstra.get(boost::vertex_color_t()), v) == boost::two_bit_black) {
+      put(imported.get(boost::vertex_color_t()), v, boost::two_bit_black);
+      put(imported.get(boost::vertex_distance_t()), v, get(distance, v));
+    }
+  }
+  blink::import_frontier(imported, frontier);
+  imported.expand();
+  blink::reset_dijkstra_queue_by_frontier(
+    dijkstra.get(boost::max_priority_queue_t()));
+  dijkstra.expand();
+
+  // dijkstra_object: pause at distance 2, rebuild the queue and continue
+  std::vector<vertex_descriptor> sources(1, orig);
+  distance_map_type object_distance(n, index);
+  auto object_queue = blink::make_frontier_tracking_queue(g, object_distance,
+    std::less<double>(), index);
+  auto object = blink::make_dijkstra_object(g, sources, 
+    blink::only_finish_vertex_type(), 
+    boost::distance_map(object_distance).max_priority_queue(object_queue));
+  while (object() && get(object_distance, object.get_u()) < 2) {}
+  std::cout << "Object frontier at distance 2: " 
+    << blink::export_frontier(object).size() << " vertices" << std::endl;
+  blink::reset_dijkstra_queue_by_frontier(
+    object.get(boost::max_priority_queue_t()));
+  while (object()) {}
+
+  const bool same = equals_plain(g, dijkstra, orig) 
+    && equals_plain(g, imported, orig) && equals_plain(g, object, orig);
+  std::cout << "Rebuilt and imported searches equal single search: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+void test_deadline_blink(int n)
+{
+  std::cout << "Test Deadline Blink" << std::endl;
+
+  // A larger ring, so that the search takes several slices
+  graph_type g = make_a_simple_graph(n * 1000);
+  const vertex_descriptor orig = 4;
+
+  auto dijkstra = blink::make_resumable_dijkstra(g);
+  dijkstra.init_from_source(orig);
+  blink::deadline_interruptor deadline(std::chrono::microseconds(50));
+  std::size_t slices = 1;
+  while (!dijkstra.expand(deadline)) {
+    deadline.restart();
+    ++slices;
+  }
+  std::cout << "Slices of 50 microseconds: " << slices << std::endl;
+
+  std::cout << "Sliced search equals single search: " 
+    << (equals_plain(g, dijkstra, orig) ? "yes" : "no") << std::endl 
+    << std::endl;
+}
+
+void test_expand_for_blink(int n)
+{
+  std::cout << "Test Expand For Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  const vertex_descriptor orig = 4;
+
+  // Budgets of 5 settled vertices
+  auto dijkstra = blink::make_resumable_dijkstra(g);
+  dijkstra.init_from_source(orig);
+  std::cout << "Settled" << '\t' << "Scanned" << '\t' << "Radius" << '\t' 
+    << "Completed" << std::endl;
+  bool completed = false;
+  while (!completed) {
+    blink::expand_statistics<double> statistics 
+      = blink::expand_for(dijkstra, 5);
+    std::cout << statistics.vertices_settled << '\t' 
+      << statistics.edges_scanned << '\t' << statistics.radius << '\t'
+      << statistics.completed << std::endl;
+    completed = statistics.completed;
+  }
+
+  std::cout << "Budgeted search equals single search: " 
+    << (equals_plain(g, dijkstra, orig) ? "yes" : "no") << std::endl 
+    << std::endl;
+}
+
+// Done callback of the scheduled searches, called on the worker threads
+struct count_done
+{
+  count_done(std::atomic<std::size_t>& count) : m_count(&count)
+  {}
+
+  template<typename Dijkstra>
+  void operator()(const Dijkstra&) const
+  {
+    ++*m_count;
+  }
+
+  std::atomic<std::size_t>* m_count;
+};
+
+void test_scheduler_blink(int n)
+{
+  std::cout << "Test Scheduler Blink" << std::endl;
+
+  // A larger ring, so that the searches take several slices
+  graph_type g = make_a_simple_graph(n * 100);
+  std::vector<vertex_descriptor> sources;
+  sources.push_back(0);
+  sources.push_back(4);
+  sources.push_back(7);
+
+  // Searches share their state with their copy in the scheduler
+  typedef blink::resumable_dijkstra_helper<graph_type, 
+    boost::no_named_parameters>::type dijkstra_type;
+  std::vector<dijkstra_type> searches;
+  std::atomic<std::size_t> done(0);
+  blink::search_scheduler scheduler(2, std::chrono::microseconds(20));
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    searches.push_back(blink::make_resumable_dijkstra(g));
+    searches.back().init_from_source(sources[i]);
+    scheduler.submit(searches.back(), blink::exhaustive_search_goal(), 
+      count_done(done), int(i));
+  }
+  scheduler.wait();
+  std::cout << "Completed " << done << " searches in " 
+    << scheduler.statistics().slices << " slices" << std::endl;
+
+  bool same = done == sources.size();
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    same = same && equals_plain(g, searches[i], sources[i]);
+  }
+  std::cout << "Scheduled searches equal single searches: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+// Consumer of an event_pipeline, copies the distances of finished vertices
+class copy_distance_visitor : public boost::default_dijkstra_visitor
+{
+public:
+  copy_distance_visitor(distance_map_type distance, std::size_t n)
+    : m_distance(distance), m_copy(n, std::numeric_limits<double>::max())
+  {}
+
+  template<typename U, typename G>
+  void finish_vertex(const U& u, const G&)
+  {
+    m_copy[u] = get(m_distance, u);
+  }
+
+  const std::vector<double>& copy() const
+  {
+    return m_copy;
+  }
+
+private:
+  distance_map_type m_distance;
+  std::vector<double> m_copy;
+};
+
+void test_pipeline_blink(int n)
+{
+  std::cout << "Test Pipeline Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  const vertex_descriptor orig = 4;
+  distance_map_type distance(n, get(boost::vertex_index, g));
+  auto dijkstra = blink::make_resumable_dijkstra(g, 
+    boost::distance_map(distance));
+  dijkstra.init_from_source(orig);
+
+  // Two consumers with room for 4 events, the search pauses while they 
+  // are behind
+  std::vector<copy_distance_visitor> consumers(2, 
+    copy_distance_visitor(distance, n));
+  blink::event_pipeline<graph_type, copy_distance_visitor> pipeline(g, 
+    consumers, 4);
+  auto vis = pipeline.visitor();
+  std::size_t pauses = 0;
+  while (!dijkstra.expand(vis, vis)) {
+    while (!pipeline.flush()) {
+      std::this_thread::yield();
+    }
+    ++pauses;
+  }
+  pipeline.close();
+  std::cout << "Search paused " << pauses << " times" << std::endl;
+
+  auto state = blink::dijkstra_shortest_path_plain(g, orig);
+  bool same = true;
+  for (std::size_t i = 0; i < pipeline.size(); ++i) {
+    BGL_FORALL_VERTICES(v, g, graph_type) {
+      same = same && pipeline.consumer_visitor(i).copy()[v]
+        == get(state.get<boost::vertex_distance_t>(), v);
+    }
+  }
+  std::cout << "Consumed distances equal single search: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+void test_expand_async_blink(int n)
+{
+  std::cout << "Test Expand Async Blink" << std::endl;
+
+  // A larger ring, so that the searches take several slices
+  graph_type g = make_a_simple_graph(n * 100);
+  const vertex_descriptor orig = 4;
+
+  // The inline executor runs all slices before the call returns, the 
+  // thread pool runs them on its workers
+  blink::inline_executor executor;
+  blink::thread_pool pool(2);
+  auto dijkstra = blink::make_resumable_dijkstra(g);
+  auto dijkstra2 = blink::make_resumable_dijkstra(g);
+  dijkstra.init_from_source(orig);
+  dijkstra2.init_from_source(orig);
+  std::future<bool> completed = blink::expand_async_future(dijkstra, 
+    blink::default_interruptor(), boost::default_dijkstra_visitor(), 
+    executor, blink::cancellation_flag(), std::chrono::microseconds(20));
+  std::future<bool> completed2 = blink::expand_async_future(dijkstra2, 
+    blink::default_interruptor(), boost::default_dijkstra_visitor(), pool,
+    blink::cancellation_flag(), std::chrono::microseconds(20));
+  const bool same = completed.get() && completed2.get() 
+    && equals_plain(g, dijkstra, orig) && equals_plain(g, dijkstra2, orig);
+
+  std::cout << "Asynchronous searches equal single search: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+// Counts the relaxed edges, copies share the count
+class count_relaxed_visitor : public boost::default_dijkstra_visitor
+{
+public:
+  count_relaxed_visitor() : m_count(new std::size_t(0))
+  {}
+
+  template<typename E, typename G>
+  void edge_relaxed(const E&, const G&)
+  {
+    ++*m_count;
+  }
+
+  std::size_t count() const
+  {
+    return *m_count;
+  }
+
+private:
+  boost::shared_ptr<std::size_t> m_count;
+};
+
+void test_composed_visitor_blink(int n)
+{
+  std::cout << "Test Composed Visitor Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  const vertex_descriptor orig = 4;
+  auto dijkstra = blink::make_resumable_dijkstra(g);
+  dijkstra.init_from_source(orig);
+
+  // The default visitor handles no events and is not called at all
+  typedef blink::distance_visitor_helper_indirect<graph_type, 
+    boost::no_named_parameters>::type distance_visitor_type;
+  typedef blink::composed_visitor<distance_visitor_type, 
+    count_relaxed_visitor, boost::default_dijkstra_visitor> visitor_type;
+  typedef visitor_type::control_map<graph_type>::type control_map_type;
+  std::cout << "Handles finish_vertex: " 
+    << control_map_type::contains(blink::cp_finish_vertex)
+    << " edge_relaxed: " << control_map_type::contains(blink::cp_edge_relaxed)
+    << " examine_edge: " << control_map_type::contains(blink::cp_examine_edge)
+    << std::endl;
+
+  // The distance visitor is also the interruptor, it gets its events 
+  // through the composed visitor
+  distance_visitor_type target = blink::make_distance_visitor(
+    dijkstra.get_dijkstra_state(), 3.0);
+  count_relaxed_visitor relaxed;
+  dijkstra.expand(target, blink::compose_visitors(target, relaxed, 
+    boost::default_dijkstra_visitor()));
+  std::cout << "Edges relaxed until distance 3: " << relaxed.count() 
+    << std::endl;
+  dijkstra.expand();
+
+  std::cout << "Composed visitor search equals single search: " 
+    << (equals_plain(g, dijkstra, orig) ? "yes" : "no") << std::endl 
+    << std::endl;
+}
+
+void test_counters_blink(int n)
+{
+  std::cout << "Test Counters Blink" << std::endl;
+
+  graph_type g = make_a_simple_graph(n);
+  const vertex_descriptor orig = 4;
+  vertex_index_map_type index = get(boost::vertex_index, g);
+
+  // The queue counts the heap operations, the visitor the search events
+  distance_map_type distance(n, index);
+  auto queue = blink::make_counting_queue(g, distance, std::less<double>(), 
+    index);
+  auto dijkstra = blink::make_resumable_dijkstra(g, 
+    boost::distance_map(distance).max_priority_queue(queue));
+  dijkstra.init_from_source(orig);
+  blink::dijkstra_counters events;
+  dijkstra.expand(blink::default_interruptor(), 
+    blink::make_counting_visitor(events));
+  const blink::dijkstra_counters counters = events 
+    + dijkstra.get(boost::max_priority_queue_t()).counters();
+
+  std::cout << "Finished: " << counters.vertices_finished 
+    << " Relaxed: " << counters.edges_relaxed 
+    << " Not relaxed: " << counters.edges_not_relaxed 
+    << " Pushes: " << counters.heap_pushes 
+    << " Pops: " << counters.heap_pops 
+    << " Max heap: " << counters.max_heap_size << std::endl;
+
+  const bool same = equals_plain(g, dijkstra, orig) 
+    && counters.vertices_finished == std::size_t(n) 
+    && counters.heap_pops == std::size_t(n);
+  std::cout << "Counted search equals single search: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::bidirectionalS,
+  boost::no_property, edge_prop> bidirectional_graph_type;
+typedef boost::graph_traits<bidirectional_graph_type>::edge_descriptor 
+  bidirectional_edge_type;
+
+// Prints the repaired and fresh distances and whether they are equal
+template<typename Dijkstra>
+void report_repair(const bidirectional_graph_type& g, Dijkstra& repaired,
+  Dijkstra& reopened, vertex_descriptor orig)
+{
+  auto fresh = blink::dijkstra_shortest_path_plain(g, orig);
+  std::cout << "Vertex" << '\t' << "Repair" << '\t' << "Reopen" << '\t' 
+    << "Fresh" << std::endl;
+  bool same = true;
+  BGL_FORALL_VERTICES(v, g, bidirectional_graph_type) {
+    const double a = get(repaired.get(boost::vertex_distance_t()), v);
+    const double b = get(reopened.get(boost::vertex_distance_t()), v);
+    const double c = get(fresh.get<boost::vertex_distance_t>(), v);
+    std::cout << v << '\t' << a << '\t' << b << '\t' << c << std::endl;
+    same = same && a == c && b == c;
+  }
+  std::cout << "Repaired searches equal fresh search: " 
+    << (same ? "yes" : "no") << std::endl << std::endl;
+}
+
+void test_repair_blink(int n)
+{
+  std::cout << "Test Repair Blink" << std::endl;
+
+  bidirectional_graph_type g(n);
+  for (int i = 0; i < n; ++i) {
+    boost::add_edge(i, (i + 1) % n, 1.0, g);
+    boost::add_edge((i + 1) % n, i, 1.0, g);
+  }
+  const vertex_descriptor orig = 4;
+  predecessor_map_type predecessor(n, get(boost::vertex_index, g));
+  predecessor_map_type predecessor2(n, get(boost::vertex_index, g));
+
+  // repair() reopens and expands, reopen_edges() only reopens and must be
+  // followed by an expansion with the reopen visitor
+  auto repaired = blink::make_resumable_dijkstra(g, 
+    boost::predecessor_map(predecessor));
+  auto reopened = blink::make_resumable_dijkstra(g, 
+    boost::predecessor_map(predecessor2));
+  repaired.init_from_source(orig);
+  repaired.expand();
+  reopened.init_from_source(orig);
+  reopened.expand();
+
+  // A tree edge becomes longer, the subtree below it is reset and reached
+  // around the ring
+  std::vector<bidirectional_edge_type> changed(1, 
+    boost::edge(orig, orig + 1, g).first);
+  put(boost::edge_weight, g, changed[0], 10.0);
+  blink::repair(repaired, changed);
+  blink::reopen_edges(reopened, changed);
+  reopened.expand(blink::default_interruptor(), 
+    blink::make_reopen_visitor(reopened));
+  std::cout << "Edge 4-5 from 1 to 10" << std::endl;
+  report_repair(g, repaired, reopened, orig);
+
+  // An edge becomes shorter, the vertices behind it get closer
+  changed[0] = boost::edge(orig, orig - 1, g).first;
+  put(boost::edge_weight, g, changed[0], 0.5);
+  blink::repair(repaired, changed);
+  blink::reopen_edges(reopened, changed);
+  reopened.expand(blink::default_interruptor(), 
+    blink::make_reopen_visitor(reopened));
+  std::cout << "Edge 4-3 from 1 to 0.5" << std::endl;
+  report_repair(g, repaired, reopened, orig);
+}
+
+void test_many_to_many_blink(int n)
+{
+  std::cout << "Test Many To Many Blink" << std::endl;
+
+  bidirectional_graph_type g(n);
+  for (int i = 0; i < n; ++i) {
+    boost::add_edge(i, (i + 1) % n, 1.0, g);
+    boost::add_edge((i + 1) % n, i, 1.0, g);
+  }
+  blink::thread_pool pool(2);
+  std::vector<vertex_descriptor> sources;
+  sources.push_back(0);
+  sources.push_back(4);
+  sources.push_back(7);
+  std::vector<vertex_descriptor> targets;
+  targets.push_back(2);
+  targets.push_back(9);
+
+  // The backward searches stop at radius 2, the forward searches must
+  // make up for the rest
+  std::vector<double> table(sources.size() * targets.size());
+  blink::many_to_many_distances(g, sources, targets, table.begin(), pool, 2.0);
+
+  std::cout << "Source" << '\t' << "To 2" << '\t' << "To 9" << std::endl;
+  bool same = true;
+  for (std::size_t s = 0; s < sources.size(); ++s) {
+    auto state = blink::dijkstra_shortest_path_plain(g, sources[s]);
+    std::cout << sources[s];
+    for (std::size_t t = 0; t < targets.size(); ++t) {
+      const double d = table[s * targets.size() + t];
+      std::cout << '\t' << d;
+      same = same && d == get(state.get<boost::vertex_distance_t>(), targets[t]);
+    }
+    std::cout << std::endl;
+  }
+  std::cout << "Table equals single searches: " << (same ? "yes" : "no") 
+    << std::endl << std::endl;
+}
 
 void test_distance_visitor_convenience(int n)
 {
@@ -396,6 +1084,37 @@ void test_dijkstra_object2(int n)
   }
 }
 
+void test_dijkstra_object_fill(int n)
+{
+  std::cout << "Test Dijkstra Object - filling a buffer of events" << std::endl;
+
+  typedef std::vector<vertex_descriptor> source_range_type; 
+  typedef blink::dijkstra_visitor_control_point_vector control_map_type;
+  
+  typedef blink::dijkstra_object_helper<
+    graph_type, 
+    source_range_type, 
+    control_map_type, 
+    boost::no_named_parameters>::type dijkstra_object_type;
+  
+  graph_type g = make_a_simple_graph(n);
+  vertex_descriptor orig = 4;
+  source_range_type sources(1,orig);
+
+  dijkstra_object_type dijkstra = blink::make_dijkstra_object(g, sources, control_map_type());
+  
+  dijkstra_object_type::event_type buffer[8];
+  std::size_t filled = 8;
+  while(filled == 8) {
+    filled = dijkstra.fill(buffer, buffer + 8);
+    std::cout << "batch of " << filled << " events:";
+    for(std::size_t i = 0; i < filled; ++i) {
+      std::cout << " " << buffer[i].cp << "(" << buffer[i].vertex() << ")";
+    }
+    std::cout << std::endl;
+  }
+}
+
 void test_with_boost_heap(int n)
 {
   typedef boost::indirect_cmp<distance_map_type, std::greater<double> > indirect_compare;
@@ -453,6 +1172,22 @@ int main()
   
   test_classic_boost(n);
   test_classic_blink(n);
+  test_parallel_blink(n);
+  test_batch_blink(n);
+  test_multi_lane_blink(n);
+  test_search_cache_blink(n);
+  test_state_io_blink(n);
+  test_fork_blink(n);
+  test_frontier_blink(n);
+  test_deadline_blink(n);
+  test_expand_for_blink(n);
+  test_scheduler_blink(n);
+  test_pipeline_blink(n);
+  test_expand_async_blink(n);
+  test_composed_visitor_blink(n);
+  test_counters_blink(n);
+  test_repair_blink(n);
+  test_many_to_many_blink(n);
   
   test_nearest_visitor(n);
   test_nearest_visitor_convenience(n);
@@ -460,6 +1195,7 @@ int main()
   test_dijkstra_object(n);
   test_dijkstra_object2(n);
   test_dijkstra_object3(n);
+  test_dijkstra_object_fill(n);
   test_with_boost_heap(n);
 
   return 0;
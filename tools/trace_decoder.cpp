@@ -0,0 +1,148 @@
+//
+//=======================================================================
+// Copyright 2014
+// Author: Alex Hagen-Zanker
+//
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//=======================================================================
+//
+// Renders a trace file written by blink::write_trace as the text of the
+// logging_visitor, or as Chrome trace JSON that can be opened in Perfetto
+// or chrome://tracing. In the JSON every vertex is a slice from
+// examine_vertex to finish_vertex, the other events are instants.
+//
+// usage: trace_decoder [--text|--json] trace_file
+//
+//=======================================================================
+//
+#include <blink/graph/dijkstra_control.hpp>
+#include <blink/graph/dijkstra_visitor/trace_visitor.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const char* event_name(std::uint32_t cp)
+{
+  switch (cp) {
+  case blink::cp_initialize_vertex: return "initialize_vertex";
+  case blink::cp_examine_vertex: return "examine_vertex";
+  case blink::cp_examine_edge: return "examine_edge";
+  case blink::cp_discover_vertex: return "discover_vertex";
+  case blink::cp_finish_vertex: return "finish_vertex";
+  case blink::cp_edge_relaxed: return "edge_relaxed";
+  case blink::cp_edge_not_relaxed: return "edge_not_relaxed";
+  default: return "unknown";
+  }
+}
+
+bool is_edge_event(std::uint32_t cp)
+{
+  return cp == blink::cp_examine_edge || cp == blink::cp_edge_relaxed
+    || cp == blink::cp_edge_not_relaxed;
+}
+
+// The same text as blink::logging_visitor
+void write_text(std::ostream& os,
+  const std::vector<blink::trace_record>& records)
+{
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const blink::trace_record& r = records[i];
+    const std::string name = event_name(r.cp);
+    os << name << std::string(name.size() < 18 ? 18 - name.size() : 1, ' ')
+      << r.u;
+    if (is_edge_event(r.cp)) {
+      os << " - " << r.v;
+    }
+    os << '\n';
+  }
+}
+
+// Chrome trace event format, times in microseconds
+void write_json(std::ostream& os,
+  const std::vector<blink::trace_record>& records)
+{
+  os << "{\"traceEvents\":[\n";
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    const blink::trace_record& r = records[i];
+    const char* phase = r.cp == blink::cp_examine_vertex ? "B"
+      : r.cp == blink::cp_finish_vertex ? "E" : "i";
+    const char* name = r.cp == blink::cp_examine_vertex
+      || r.cp == blink::cp_finish_vertex ? "vertex" : event_name(r.cp);
+    os << (i == 0 ? "" : ",\n") << "{\"name\":\"" << name
+      << "\",\"ph\":\"" << phase << "\",\"ts\":" << r.time / 1000 << '.'
+      << (r.time % 1000) / 100 << (r.time % 100) / 10 << r.time % 10
+      << ",\"pid\":1,\"tid\":1";
+    if (phase[0] == 'i') {
+      os << ",\"s\":\"t\"";
+    }
+    os << ",\"args\":{\"u\":" << r.u;
+    if (is_edge_event(r.cp)) {
+      os << ",\"v\":" << r.v;
+    }
+    os << "}}";
+  }
+  os << "\n]}\n";
+}
+
+int main(int argc, char* argv[])
+{
+  bool json = false;
+  const char* file = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--json") == 0) {
+      json = true;
+    } else if (std::strcmp(argv[i], "--text") == 0) {
+      json = false;
+    } else {
+      file = argv[i];
+    }
+  }
+  if (file == 0) {
+    std::cerr << "usage: trace_decoder [--text|--json] trace_file"
+      << std::endl;
+    return 2;
+  }
+
+  std::ifstream is(file, std::ios::binary);
+  blink::trace_file_header header;
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))
+    || std::memcmp(header.magic, "BLKTRACE", 8) != 0
+    || header.version != 1
+    || header.record_size != sizeof(blink::trace_record)) {
+    std::cerr << file << " is not a trace file" << std::endl;
+    return 1;
+  }
+
+  // check the count against the file size before allocating for it
+  const std::streampos first = is.tellg();
+  is.seekg(0, std::ios::end);
+  const std::uint64_t bytes = is.tellg() - first;
+  is.seekg(first);
+  if (header.count > bytes / sizeof(blink::trace_record)) {
+    std::cerr << file << " is truncated" << std::endl;
+    return 1;
+  }
+
+  std::vector<blink::trace_record> records(header.count);
+  if (header.count > 0 && !is.read(reinterpret_cast<char*>(&records[0]),
+    header.count * sizeof(blink::trace_record))) {
+    std::cerr << file << " could not be read" << std::endl;
+    return 1;
+  }
+  if (header.dropped > 0) {
+    std::cerr << header.dropped << " events were dropped" << std::endl;
+  }
+
+  if (json) {
+    write_json(std::cout, records);
+  } else {
+    write_text(std::cout, records);
+  }
+  return 0;
+}